@@ -0,0 +1,224 @@
+#include "s21_band_matrix.h"
+
+#include <algorithm>
+
+namespace s_21 {
+// CONSTRUCTORS
+
+S21BandMatrix::S21BandMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper) {
+  if (size <= 0 || lower < 0 || upper < 0) {
+    throw std::invalid_argument(
+        "CreationError: The size cannot be less than 1 and the bandwidths "
+        "cannot be negative");
+  }
+  // bands wider than the matrix only waste memory
+  lower_ = std::min(lower_, size_ - 1);
+  upper_ = std::min(upper_, size_ - 1);
+  data_.assign(static_cast<std::size_t>(size_) * Width(), 0);
+}
+
+S21BandMatrix::S21BandMatrix(const S21Matrix& matrix, int lower, int upper)
+    : S21BandMatrix(matrix.rows_ > 0 ? matrix.rows_ : 1, lower, upper) {
+  if (!matrix.IsMatrixSquare() || matrix.rows_ <= 0) {
+    throw std::range_error("ConversionError: The matrix must be square");
+  }
+
+  for (int i = 0; i < size_; i++) {
+    int first_col = std::max(0, i - lower_);
+    int last_col = std::min(size_ - 1, i + upper_);
+    for (int j = first_col; j <= last_col; j++) {
+      Value(i, j) = matrix.matrix_[i][j];
+    }
+  }
+}
+
+// GETTERS
+
+int S21BandMatrix::GetSize() const { return size_; }
+
+int S21BandMatrix::GetLower() const { return lower_; }
+
+int S21BandMatrix::GetUpper() const { return upper_; }
+
+// OVERLOAD OPERATORS
+
+double& S21BandMatrix::operator()(int row, int col) {
+  if (row < 0 || col < 0 || row >= size_ || col >= size_ ||
+      !IsInBand(row, col)) {
+    throw std::out_of_range(
+        "InvalidIndexError: Index is out of range or outside the band");
+  }
+
+  return Value(row, col);
+}
+
+const double& S21BandMatrix::operator()(int row, int col) const {
+  static const double kZero = 0;
+  if (row < 0 || col < 0 || row >= size_ || col >= size_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  return IsInBand(row, col) ? Value(row, col) : kZero;
+}
+
+// MEMBER FUNCTIONS
+
+S21Matrix S21BandMatrix::ToMatrix() const {
+  S21Matrix matrix(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    int first_col = std::max(0, i - lower_);
+    int last_col = std::min(size_ - 1, i + upper_);
+    for (int j = first_col; j <= last_col; j++) {
+      matrix.matrix_[i][j] = Value(i, j);
+    }
+  }
+
+  return matrix;
+}
+
+double S21BandMatrix::Determinant() const {
+  S21BandMatrix lu(size_, lower_, lower_ + upper_);
+  std::vector<int> pivots;
+  double det = Factorize(lu, pivots);
+  for (int i = 0; i < size_ && det; i++) {
+    det *= lu.Value(i, i);
+  }
+
+  return det;
+}
+
+S21Matrix S21BandMatrix::Solve(const S21Matrix& b) const {
+  if (b.rows_ != size_) {
+    throw std::range_error(
+        "SolveError: Incompatible matrix sizes to solve the system");
+  }
+
+  S21BandMatrix lu(size_, lower_, lower_ + upper_);
+  std::vector<int> pivots;
+  if (!Factorize(lu, pivots)) {
+    throw std::range_error("SolveError: The matrix is singular");
+  }
+
+  S21Matrix res_matrix(b);
+  res_matrix.Detach();
+  // the multipliers were not moved by later swaps, so L is applied in the
+  // same interleaved order as during the elimination
+  for (int k = 0; k < size_; k++) {
+    if (pivots[k] != k) {
+      std::swap_ranges(res_matrix.matrix_[k], res_matrix.matrix_[k] + b.cols_,
+                       res_matrix.matrix_[pivots[k]]);
+    }
+    const double* x_k = res_matrix.matrix_[k];
+    for (int i = k + 1; i <= std::min(size_ - 1, k + lower_); i++) {
+      double l_ik = lu.Value(i, k);
+      double* x_i = res_matrix.matrix_[i];
+      for (int j = 0; j < b.cols_; j++) {
+        x_i[j] -= l_ik * x_k[j];
+      }
+    }
+  }
+  for (int i = size_ - 1; i >= 0; i--) {
+    double* x_i = res_matrix.matrix_[i];
+    for (int k = i + 1; k <= std::min(size_ - 1, i + lu.upper_); k++) {
+      double u_ik = lu.Value(i, k);
+      const double* x_k = res_matrix.matrix_[k];
+      for (int j = 0; j < b.cols_; j++) {
+        x_i[j] -= u_ik * x_k[j];
+      }
+    }
+    double u_ii = lu.Value(i, i);
+    for (int j = 0; j < b.cols_; j++) {
+      x_i[j] /= u_ii;
+    }
+  }
+
+  return res_matrix;
+}
+
+void S21BandMatrix::Gemv(double alpha, const S21Vector& x, double beta,
+                         S21Vector& y) const {
+  if (x.size_ != size_ || y.size_ != size_) {
+    throw std::range_error("GemvError: Incorrect dimensions of the vectors");
+  }
+
+  S21Vector product(size_);
+  for (int i = 0; i < size_; i++) {
+    const double* row = &data_[static_cast<std::size_t>(i) * Width()];
+    int first_col = std::max(0, i - lower_);
+    int last_col = std::min(size_ - 1, i + upper_);
+    double sum = 0;
+    for (int j = first_col; j <= last_col; j++) {
+      sum += row[j - i + lower_] * x.data_[j];
+    }
+    product.data_[i] = sum;
+  }
+
+  for (int i = 0; i < size_; i++) {
+    y.data_[i] = beta == 0 ? alpha * product.data_[i]
+                           : alpha * product.data_[i] + beta * y.data_[i];
+  }
+}
+
+// PRIVATE MEMBER FUNCTIONS
+
+int S21BandMatrix::Width() const { return lower_ + upper_ + 1; }
+
+double& S21BandMatrix::Value(int row, int col) {
+  return data_[static_cast<std::size_t>(row) * Width() + col - row + lower_];
+}
+
+const double& S21BandMatrix::Value(int row, int col) const {
+  return data_[static_cast<std::size_t>(row) * Width() + col - row + lower_];
+}
+
+bool S21BandMatrix::IsInBand(int row, int col) const {
+  return col >= row - lower_ && col <= row + upper_;
+}
+
+int S21BandMatrix::Factorize(S21BandMatrix& lu,
+                             std::vector<int>& pivots) const {
+  for (int i = 0; i < size_; i++) {
+    for (int j = std::max(0, i - lower_); j <= std::min(size_ - 1, i + upper_);
+         j++) {
+      lu.Value(i, j) = Value(i, j);
+    }
+  }
+  pivots.resize(size_);
+
+  int sign = 1;
+  for (int k = 0; k < size_; k++) {
+    int last_row = std::min(size_ - 1, k + lower_);
+    int last_col = std::min(size_ - 1, k + lu.upper_);
+    int pivot_row = k;
+    for (int i = k + 1; i <= last_row; i++) {
+      if (std::fabs(lu.Value(i, k)) > std::fabs(lu.Value(pivot_row, k))) {
+        pivot_row = i;
+      }
+    }
+    pivots[k] = pivot_row;
+    if (lu.Value(pivot_row, k) == 0) {
+      return 0;
+    }
+    if (pivot_row != k) {
+      // only the columns right of the multipliers are swapped
+      for (int j = k; j <= last_col; j++) {
+        std::swap(lu.Value(k, j), lu.Value(pivot_row, j));
+      }
+      sign = -sign;
+    }
+
+    double pivot = lu.Value(k, k);
+    for (int i = k + 1; i <= last_row; i++) {
+      double factor = lu.Value(i, k) / pivot;
+      lu.Value(i, k) = factor;
+      for (int j = k + 1; j <= last_col; j++) {
+        lu.Value(i, j) -= factor * lu.Value(k, j);
+      }
+    }
+  }
+
+  return sign;
+}
+
+}  // namespace s_21
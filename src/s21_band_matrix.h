@@ -0,0 +1,83 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_BAND_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_BAND_MATRIX_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_vector.h"
+
+namespace s_21 {
+// Square matrix with lower sub- and upper superdiagonals, each row stores
+// only the lower + upper + 1 values of the band
+class S21BandMatrix {
+ public:
+  // Constructors
+
+  /**
+   * @throws CreationError: The size cannot be less than 1 and the bandwidths
+   * cannot be negative
+   */
+  S21BandMatrix(int size, int lower, int upper);
+  /**
+   * Takes the band of the matrix, the values outside it are not read
+   * @throws ConversionError: The matrix must be square
+   */
+  S21BandMatrix(const S21Matrix& matrix, int lower, int upper);
+
+  // Getters
+
+  int GetSize() const;
+  int GetLower() const;
+  int GetUpper() const;
+
+  // Overload operators
+
+  /**
+   * @throws InvalidIndexError: Index is out of range or outside the band
+   */
+  double& operator()(int row, int col);
+  /**
+   * Values outside the band read as zero
+   * @throws InvalidIndexError: Index is out of range
+   */
+  const double& operator()(int row, int col) const;
+
+  // Member functions
+
+  S21Matrix ToMatrix() const;
+  /**
+   * Banded LU decomposition, O(n * lower * (lower + upper))
+   */
+  double Determinant() const;
+  /**
+   * Solves this * X = b by banded LU decomposition with partial pivoting,
+   * O(n * lower * (lower + upper)) plus O(n * (lower + upper)) per column of b
+   * @throws SolveError: The matrix is singular or b has a wrong number of rows
+   */
+  S21Matrix Solve(const S21Matrix& b) const;
+  /**
+   * y = alpha * this * x + beta * y, O(n * (lower + upper))
+   * @throws GemvError: Incorrect dimensions of the vectors
+   */
+  void Gemv(double alpha, const S21Vector& x, double beta, S21Vector& y) const;
+
+ private:
+  int size_, lower_, upper_;
+  std::vector<double> data_;
+
+  int Width() const;
+  // unchecked access to a value inside the band
+  double& Value(int row, int col);
+  const double& Value(int row, int col) const;
+  bool IsInBand(int row, int col) const;
+  /**
+   * Eliminates into lu, a band with upper + lower superdiagonals for the fill
+   * of row swaps. Returns the sign of the permutation, 0 for a singular matrix
+   */
+  int Factorize(S21BandMatrix& lu, std::vector<int>& pivots) const;
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_BAND_MATRIX_H_
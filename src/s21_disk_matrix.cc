@@ -0,0 +1,449 @@
+#include "s21_disk_matrix.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <system_error>
+#include <thread>
+
+#include "s21_gemm.h"
+
+namespace s_21 {
+namespace {
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+
+// keeps the values aligned to a cache line
+struct FileHeader {
+  char magic[8];
+  std::int32_t rows;
+  std::int32_t cols;
+  char reserved[48];
+};
+static_assert(sizeof(FileHeader) == 64, "the values must start at 64 bytes");
+
+// every tile pair is double buffered and so is the result tile
+constexpr int kTileBuffers = 6;
+
+[[noreturn]] void ThrowSystemError(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(),
+                          "DiskMatrixError: " + what);
+}
+
+// compares the files behind the paths, also through links
+bool IsSameFile(const std::string& path, const std::string& other) {
+  struct stat info, other_info;
+  return ::stat(path.c_str(), &info) == 0 &&
+         ::stat(other.c_str(), &other_info) == 0 &&
+         info.st_dev == other_info.st_dev && info.st_ino == other_info.st_ino;
+}
+
+std::size_t FileSize(int rows, int cols) {
+  return sizeof(FileHeader) +
+         static_cast<std::size_t>(rows) * cols * sizeof(double);
+}
+
+// runs blocking file work in submission order off the computing thread
+class IoThread {
+ public:
+  IoThread() : stop_(false), thread_([this] { Loop(); }) {}
+
+  // finishes the queued tasks first
+  ~IoThread() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    tasks_cv_.notify_one();
+    thread_.join();
+  }
+
+  std::future<void> Submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> future = packaged.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push(std::move(packaged));
+    }
+    tasks_cv_.notify_one();
+    return future;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable tasks_cv_;
+  std::queue<std::packaged_task<void()>> tasks_;
+  bool stop_;
+  std::thread thread_;
+
+  void Loop() {
+    while (true) {
+      std::packaged_task<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        tasks_cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+};
+}  // namespace
+
+// CONSTRUCTORS
+
+S21DiskMatrix::S21DiskMatrix(const std::string& path, int rows, int cols)
+    : path_(path),
+      rows_(rows),
+      cols_(cols),
+      writable_(true),
+      map_(nullptr),
+      map_size_(0),
+      values_(nullptr) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "CreationError: The number of rows or cols cannot be less than 1");
+  }
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    ThrowSystemError("Cannot create " + path);
+  }
+  try {
+    // a truncated file reads as zeros without writing them
+    if (::ftruncate(fd, FileSize(rows, cols)) != 0) {
+      ThrowSystemError("Cannot resize " + path);
+    }
+    Map(fd, FileSize(rows, cols), true);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+
+  FileHeader* header = static_cast<FileHeader*>(map_);
+  std::memcpy(header->magic, kMagic, sizeof(kMagic));
+  header->rows = rows;
+  header->cols = cols;
+}
+
+S21DiskMatrix::S21DiskMatrix(const std::string& path, const S21Matrix& matrix)
+    : S21DiskMatrix(path, matrix.GetRows(), matrix.GetCols()) {
+  WriteBlock(0, 0, matrix);
+}
+
+S21DiskMatrix::S21DiskMatrix(const std::string& path, Mode mode)
+    : path_(path),
+      rows_(0),
+      cols_(0),
+      writable_(mode == Mode::kReadWrite),
+      map_(nullptr),
+      map_size_(0),
+      values_(nullptr) {
+  int fd = ::open(path.c_str(), writable_ ? O_RDWR : O_RDONLY);
+  if (fd < 0) {
+    ThrowSystemError("Cannot open " + path);
+  }
+  try {
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      ThrowSystemError("Cannot stat " + path);
+    }
+    if (static_cast<std::size_t>(info.st_size) < sizeof(FileHeader)) {
+      throw std::runtime_error("DiskMatrixError: Not a matrix file " + path);
+    }
+    Map(fd, info.st_size, writable_);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+
+  const FileHeader* header = static_cast<const FileHeader*>(map_);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) ||
+      header->rows <= 0 || header->cols <= 0 ||
+      FileSize(header->rows, header->cols) != map_size_) {
+    Unmap();
+    throw std::runtime_error("DiskMatrixError: Not a matrix file " + path);
+  }
+  rows_ = header->rows;
+  cols_ = header->cols;
+}
+
+S21DiskMatrix::S21DiskMatrix(S21DiskMatrix&& other) noexcept
+    : path_(std::move(other.path_)),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      writable_(other.writable_),
+      map_(other.map_),
+      map_size_(other.map_size_),
+      values_(other.values_) {
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.map_ = nullptr;
+  other.map_size_ = 0;
+  other.values_ = nullptr;
+}
+
+// ASSIGNMENT OPERATORS
+
+S21DiskMatrix& S21DiskMatrix::operator=(S21DiskMatrix&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    path_ = std::move(other.path_);
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    writable_ = other.writable_;
+    map_ = other.map_;
+    map_size_ = other.map_size_;
+    values_ = other.values_;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.map_ = nullptr;
+    other.map_size_ = 0;
+    other.values_ = nullptr;
+  }
+
+  return *this;
+}
+
+// DESTRUCTOR
+
+S21DiskMatrix::~S21DiskMatrix() { Unmap(); }
+
+// GETTERS
+
+int S21DiskMatrix::GetRows() const { return rows_; }
+
+int S21DiskMatrix::GetCols() const { return cols_; }
+
+const std::string& S21DiskMatrix::GetPath() const { return path_; }
+
+bool S21DiskMatrix::IsWritable() const { return writable_; }
+
+// OVERLOAD OPERATORS
+
+double& S21DiskMatrix::operator()(int row, int col) {
+  CheckBlock(row, col, 1, 1);
+  CheckWritable();
+
+  return values_[static_cast<std::size_t>(row) * cols_ + col];
+}
+
+const double& S21DiskMatrix::operator()(int row, int col) const {
+  CheckBlock(row, col, 1, 1);
+
+  return values_[static_cast<std::size_t>(row) * cols_ + col];
+}
+
+// MEMBER FUNCTIONS
+
+S21Matrix S21DiskMatrix::ReadBlock(int row, int col, int rows,
+                                   int cols) const {
+  CheckBlock(row, col, rows, cols);
+  S21Matrix block(rows, cols);
+  CopyTileOut(row, col, rows, cols, block.begin());
+
+  return block;
+}
+
+void S21DiskMatrix::WriteBlock(int row, int col, const S21Matrix& block) {
+  CheckBlock(row, col, block.GetRows(), block.GetCols());
+  CheckWritable();
+  CopyTileIn(row, col, block.GetRows(), block.GetCols(), block.begin());
+}
+
+S21Matrix S21DiskMatrix::ToMatrix() const {
+  return ReadBlock(0, 0, rows_, cols_);
+}
+
+void S21DiskMatrix::Sync() {
+  if (map_ && writable_ && ::msync(map_, map_size_, MS_SYNC) != 0) {
+    ThrowSystemError("Cannot write " + path_);
+  }
+}
+
+S21DiskMatrix S21DiskMatrix::Multiply(const S21DiskMatrix& other,
+                                      const std::string& path,
+                                      std::size_t peak_memory) const {
+  if (cols_ != other.rows_) {
+    throw std::range_error(
+        "MulMatrixError: Incorrect dimensions to multiply two matrices");
+  }
+  int tile = static_cast<int>(
+      std::sqrt(peak_memory / (kTileBuffers * sizeof(double))));
+  if (tile < 1) {
+    throw std::invalid_argument(
+        "MulMatrixError: The peak memory cannot hold the tiles");
+  }
+
+  // creating the result truncates the file while the operand maps it
+  if (IsSameFile(path, path_) || IsSameFile(path, other.path_)) {
+    throw std::invalid_argument(
+        "DiskMatrixError: The result cannot overwrite an operand");
+  }
+
+  S21DiskMatrix result(path, rows_, other.cols_);
+  int tile_rows = std::min(tile, rows_);
+  int tile_inner = std::min(tile, cols_);
+  int tile_cols = std::min(tile, other.cols_);
+  long row_tiles = (rows_ + tile_rows - 1) / tile_rows;
+  long col_tiles = (other.cols_ + tile_cols - 1) / tile_cols;
+  long inner_tiles = (cols_ + tile_inner - 1) / tile_inner;
+  long steps = row_tiles * col_tiles * inner_tiles;
+
+  struct Tile {
+    int row, col, inner;
+    int rows, cols, inner_size;
+  };
+  // steps walk the inner dimension fastest, finishing one result tile at once
+  auto tile_of = [&](long step) {
+    Tile t;
+    t.inner = step % inner_tiles * tile_inner;
+    t.col = step / inner_tiles % col_tiles * tile_cols;
+    t.row = step / inner_tiles / col_tiles * tile_rows;
+    t.rows = std::min(tile_rows, rows_ - t.row);
+    t.cols = std::min(tile_cols, other.cols_ - t.col);
+    t.inner_size = std::min(tile_inner, cols_ - t.inner);
+    return t;
+  };
+
+  std::vector<double> a_tiles[2], b_tiles[2], c_tiles[2];
+  for (int slot = 0; slot < 2; slot++) {
+    a_tiles[slot].resize(static_cast<std::size_t>(tile_rows) * tile_inner);
+    b_tiles[slot].resize(static_cast<std::size_t>(tile_inner) * tile_cols);
+    c_tiles[slot].resize(static_cast<std::size_t>(tile_rows) * tile_cols);
+  }
+  std::future<void> loaded, stored[2];
+  // declared last: its destructor drains the tasks that use the buffers
+  IoThread io;
+
+  auto load = [&](long step) {
+    Tile t = tile_of(step);
+    double* a = a_tiles[step % 2].data();
+    double* b = b_tiles[step % 2].data();
+    return io.Submit([this, &other, t, a, b] {
+      CopyTileOut(t.row, t.inner, t.rows, t.inner_size, a);
+      other.CopyTileOut(t.inner, t.col, t.inner_size, t.cols, b);
+    });
+  };
+
+  loaded = load(0);
+  for (long step = 0; step < steps; step++) {
+    Tile t = tile_of(step);
+    loaded.get();
+    // read-ahead into the pair of buffers consumed by the previous step
+    if (step + 1 < steps) {
+      loaded = load(step + 1);
+    }
+
+    int slot = step / inner_tiles % 2;
+    double* acc = c_tiles[slot].data();
+    if (t.inner == 0) {
+      // the write-behind of the tile before the previous one used the buffer
+      if (stored[slot].valid()) {
+        stored[slot].get();
+      }
+      std::fill(acc, acc + static_cast<std::size_t>(t.rows) * t.cols, 0.0);
+    }
+    Gemm(a_tiles[step % 2].data(), b_tiles[step % 2].data(), acc, t.rows,
+         t.inner_size, t.cols, S21GemmUpdate::kAccumulate);
+    if (t.inner + t.inner_size == cols_) {
+      stored[slot] = io.Submit([&result, t, acc] {
+        result.CopyTileIn(t.row, t.col, t.rows, t.cols, acc);
+        result.FlushRows(t.row, t.rows);
+      });
+    }
+  }
+  for (std::future<void>& store : stored) {
+    if (store.valid()) {
+      store.get();
+    }
+  }
+  result.Sync();
+
+  return result;
+}
+
+// PRIVATE MEMBER FUNCTIONS
+
+void S21DiskMatrix::Map(int fd, std::size_t size, bool writable) {
+  int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+  void* map = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    ThrowSystemError("Cannot map " + path_);
+  }
+
+  map_ = map;
+  map_size_ = size;
+  values_ = reinterpret_cast<double*>(static_cast<char*>(map) +
+                                      sizeof(FileHeader));
+}
+
+void S21DiskMatrix::Unmap() {
+  if (map_) {
+    ::munmap(map_, map_size_);
+    map_ = nullptr;
+    map_size_ = 0;
+    values_ = nullptr;
+  }
+}
+
+void S21DiskMatrix::CheckBlock(int row, int col, int rows, int cols) const {
+  if (row < 0 || col < 0 || rows <= 0 || cols <= 0 || row > rows_ - rows ||
+      col > cols_ - cols) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+}
+
+void S21DiskMatrix::CheckWritable() const {
+  if (!writable_) {
+    throw std::runtime_error("DiskMatrixError: The matrix is read-only");
+  }
+}
+
+void S21DiskMatrix::CopyTileOut(int row, int col, int rows, int cols,
+                                double* tile) const {
+  for (int i = 0; i < rows; i++) {
+    std::memcpy(tile + static_cast<std::size_t>(i) * cols,
+                values_ + static_cast<std::size_t>(row + i) * cols_ + col,
+                cols * sizeof(double));
+  }
+}
+
+void S21DiskMatrix::CopyTileIn(int row, int col, int rows, int cols,
+                               const double* tile) {
+  for (int i = 0; i < rows; i++) {
+    std::memcpy(values_ + static_cast<std::size_t>(row + i) * cols_ + col,
+                tile + static_cast<std::size_t>(i) * cols,
+                cols * sizeof(double));
+  }
+}
+
+void S21DiskMatrix::FlushRows(int row, int rows) {
+  // msync wants a page aligned start
+  std::uintptr_t page = ::sysconf(_SC_PAGESIZE);
+  std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(
+      values_ + static_cast<std::size_t>(row) * cols_);
+  std::uintptr_t end = reinterpret_cast<std::uintptr_t>(
+      values_ + static_cast<std::size_t>(row + rows) * cols_);
+  begin -= begin % page;
+  if (::msync(reinterpret_cast<void*>(begin), end - begin, MS_ASYNC) != 0) {
+    ThrowSystemError("Cannot write " + path_);
+  }
+}
+
+}  // namespace s_21
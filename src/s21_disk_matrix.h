@@ -0,0 +1,126 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_DISK_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_DISK_MATRIX_H_
+
+#include <cstddef>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+namespace s_21 {
+// Matrix stored row-major in a memory-mapped file, for data larger than RAM.
+// The file holds a small header with the dimensions followed by the values;
+// only the touched pages are resident and the kernel may drop clean ones.
+class S21DiskMatrix {
+ public:
+  enum class Mode { kReadOnly, kReadWrite };
+
+  static constexpr std::size_t kDefaultPeakMemory = std::size_t(1) << 28;
+
+  // Constructors
+
+  /**
+   * Creates or truncates the file and fills it with zeros
+   * @throws CreationError: The number of rows or cols cannot be less than 1
+   * @throws DiskMatrixError: the file cannot be created or mapped
+   */
+  S21DiskMatrix(const std::string& path, int rows, int cols);
+  /**
+   * Creates or truncates the file and writes the matrix into it
+   * @throws DiskMatrixError: the file cannot be created or mapped
+   */
+  S21DiskMatrix(const std::string& path, const S21Matrix& matrix);
+  /**
+   * Maps an existing file written by this class
+   * @throws DiskMatrixError: the file cannot be opened, mapped or is not a
+   * matrix file
+   */
+  explicit S21DiskMatrix(const std::string& path,
+                         Mode mode = Mode::kReadOnly);
+  S21DiskMatrix(const S21DiskMatrix& other) = delete;
+  S21DiskMatrix(S21DiskMatrix&& other) noexcept;
+
+  // Assignment operators
+
+  S21DiskMatrix& operator=(const S21DiskMatrix& other) = delete;
+  S21DiskMatrix& operator=(S21DiskMatrix&& other) noexcept;
+
+  // Destructor
+
+  /**
+   * Unmaps the file, the file itself stays on disk
+   */
+  ~S21DiskMatrix();
+
+  // Getters
+
+  int GetRows() const;
+  int GetCols() const;
+  const std::string& GetPath() const;
+  bool IsWritable() const;
+
+  // Overload operators
+
+  /**
+   * @throws InvalidIndexError: Index is out of range
+   * @throws DiskMatrixError: The matrix is read-only
+   */
+  double& operator()(int row, int col);
+  /**
+   * @throws InvalidIndexError: Index is out of range
+   */
+  const double& operator()(int row, int col) const;
+
+  // Member functions
+
+  /**
+   * Copies the rows x cols block starting at (row, col) into memory
+   * @throws InvalidIndexError: The block is out of range
+   */
+  S21Matrix ReadBlock(int row, int col, int rows, int cols) const;
+  /**
+   * @throws InvalidIndexError: The block is out of range
+   * @throws DiskMatrixError: The matrix is read-only
+   */
+  void WriteBlock(int row, int col, const S21Matrix& block);
+  S21Matrix ToMatrix() const;
+  /**
+   * Writes the modified pages back to the file and waits for the disk
+   * @throws DiskMatrixError: the pages cannot be written
+   */
+  void Sync();
+  /**
+   * this * other written to a new file at path. Square tiles are streamed
+   * through a background I/O thread that reads the next pair of tiles ahead
+   * and writes finished tiles behind the computation. The tile buffers use
+   * at most peak_memory bytes.
+   * @throws MulMatrixError: Incorrect dimensions to multiply two matrices,
+   * the peak memory cannot hold the tiles
+   * @throws DiskMatrixError: The result cannot overwrite an operand, the
+   * result file cannot be created or written
+   */
+  S21DiskMatrix Multiply(const S21DiskMatrix& other, const std::string& path,
+                         std::size_t peak_memory = kDefaultPeakMemory) const;
+
+ private:
+  std::string path_;
+  int rows_, cols_;
+  bool writable_;
+  void* map_;
+  std::size_t map_size_;
+  double* values_;
+
+  void Map(int fd, std::size_t size, bool writable);
+  void Unmap();
+  void CheckBlock(int row, int col, int rows, int cols) const;
+  void CheckWritable() const;
+  // tile exchange with contiguous row-major buffers of cols values per row
+  void CopyTileOut(int row, int col, int rows, int cols, double* tile) const;
+  void CopyTileIn(int row, int col, int rows, int cols, const double* tile);
+  // starts the write-back of the rows without waiting for it
+  void FlushRows(int row, int rows);
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_DISK_MATRIX_H_
@@ -0,0 +1,290 @@
+#include "s21_eigen.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "s21_trace.h"
+
+namespace s_21 {
+namespace {
+constexpr double kEpsilon = std::numeric_limits<double>::epsilon();
+// the tridiagonal QL converges in a few sweeps per eigenvalue
+constexpr int kMaxQlIterations = 60;
+// Ritz pairs are checked for convergence every so many Lanczos steps
+constexpr int kLanczosCheckPeriod = 8;
+
+// uniform values in (-1, 1) from splitmix64, identical on every platform
+S21Vector RandomUnitVector(int size, std::uint64_t seed) {
+  S21Vector vector(size);
+  std::uint64_t state = seed;
+  for (int i = 0; i < size; i++) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    vector(i) = static_cast<double>(z >> 11) * 0x1.0p-52 - 1;
+  }
+  vector.Scale(1 / vector.Norm());
+
+  return vector;
+}
+
+void CheckMatrix(const S21Matrix& matrix) {
+  int size = matrix.GetRows();
+  bool symmetric = size == matrix.GetCols();
+  for (int i = 0; symmetric && i < size; i++) {
+    for (int j = 0; j < i; j++) {
+      if (std::fabs(matrix.At(i, j) - matrix.At(j, i)) >
+          S21Matrix::kEqPrecision) {
+        symmetric = false;
+        break;
+      }
+    }
+  }
+  if (!symmetric) {
+    throw std::range_error(
+        "EigenError: The matrix must be square and symmetric");
+  }
+}
+
+void CheckCount(int size, int count) {
+  if (size < 1 || count < 1 || count > size) {
+    throw std::invalid_argument(
+        "EigenError: The count must be between 1 and the size");
+  }
+}
+
+S21LinearOperator MatrixOperator(const S21Matrix& matrix) {
+  return [&matrix](const S21Vector& x, S21Vector& y) {
+    matrix.Gemv(1, x, 0, y);
+  };
+}
+
+// removes the components along the basis, a second pass runs only when the
+// first one cancelled most of the vector and lost orthogonality with it
+void Orthogonalize(S21Vector& vector, const std::vector<S21Vector>& basis) {
+  for (int pass = 0; pass < 2; pass++) {
+    double norm = vector.Norm();
+    for (const S21Vector& direction : basis) {
+      vector.Axpy(-direction.Dot(vector), direction);
+    }
+    if (vector.Norm() > 0.7 * norm) {
+      break;
+    }
+  }
+}
+
+// Implicit QL on the symmetric tridiagonal matrix with the diagonal and the
+// off-diagonal (offdiagonal[i] couples i and i + 1). The diagonal becomes the
+// eigenvalues, the columns of the size x size vectors the eigenvectors. The
+// convergence checks need only the last row of the vectors, which turns the
+// O(size^3) of the full vectors into O(size^2).
+void TridiagonalEigen(std::vector<double>& diagonal,
+                      std::vector<double> offdiagonal,
+                      std::vector<double>& vectors, bool only_last_row) {
+  int size = diagonal.size();
+  int rows = only_last_row ? 1 : size;
+  offdiagonal.resize(size, 0);
+  vectors.assign(static_cast<std::size_t>(rows) * size, 0);
+  for (int i = 0; i < rows; i++) {
+    vectors[static_cast<std::size_t>(i) * size + size - rows + i] = 1;
+  }
+
+  for (int low = 0; low < size; low++) {
+    int iterations = 0;
+    int high;
+    do {
+      // look for a negligible off-diagonal value to split the matrix
+      for (high = low; high < size - 1; high++) {
+        double scale =
+            std::fabs(diagonal[high]) + std::fabs(diagonal[high + 1]);
+        if (std::fabs(offdiagonal[high]) <= kEpsilon * scale) {
+          break;
+        }
+      }
+      if (high == low) {
+        break;
+      }
+      if (++iterations > kMaxQlIterations) {
+        throw std::runtime_error(
+            "EigenError: The QL iteration did not converge");
+      }
+
+      double g = (diagonal[low + 1] - diagonal[low]) / (2 * offdiagonal[low]);
+      double r = std::hypot(g, 1.0);
+      g = diagonal[high] - diagonal[low] +
+          offdiagonal[low] / (g + std::copysign(r, g));
+      double s = 1, c = 1, p = 0;
+      int i = high - 1;
+      for (; i >= low; i--) {
+        double f = s * offdiagonal[i];
+        double b = c * offdiagonal[i];
+        r = std::hypot(f, g);
+        offdiagonal[i + 1] = r;
+        if (r == 0) {
+          diagonal[i + 1] -= p;
+          offdiagonal[high] = 0;
+          break;
+        }
+        s = f / r;
+        c = g / r;
+        g = diagonal[i + 1] - p;
+        r = (diagonal[i] - g) * s + 2 * c * b;
+        p = s * r;
+        diagonal[i + 1] = g + p;
+        g = c * r - b;
+        for (int k = 0; k < rows; k++) {
+          double* row = &vectors[static_cast<std::size_t>(k) * size];
+          f = row[i + 1];
+          row[i + 1] = s * row[i] + c * f;
+          row[i] = c * row[i] - s * f;
+        }
+      }
+      if (r == 0 && i >= low) {
+        continue;
+      }
+      diagonal[low] -= p;
+      offdiagonal[low] = g;
+      offdiagonal[high] = 0;
+    } while (true);
+  }
+}
+}  // namespace
+
+std::vector<S21EigenPair> DominantEigen(const S21Matrix& matrix, int count,
+                                        const S21EigenOptions& options) {
+  S21TraceScope trace(S21TraceOp::kDominantEigen, matrix.GetRows(),
+                      matrix.GetCols(), 0, 0, count);
+  CheckMatrix(matrix);
+  return DominantEigen(MatrixOperator(matrix), matrix.GetRows(), count,
+                       options);
+}
+
+std::vector<S21EigenPair> DominantEigen(const S21LinearOperator& matrix,
+                                        int size, int count,
+                                        const S21EigenOptions& options) {
+  CheckCount(size, count);
+  // replayed on a dense matrix of the size
+  S21TraceScope trace(S21TraceOp::kDominantEigen, size, size, 0, 0, count);
+
+  std::vector<S21EigenPair> pairs;
+  for (int found = 0; found < count; found++) {
+    S21Vector x = RandomUnitVector(size, options.seed + found);
+    bool converged = false;
+    for (int i = 0; i < options.max_iterations && !converged; i++) {
+      S21Vector y(size);
+      matrix(x, y);
+      // deflation: the pairs found so far no longer take part
+      for (const S21EigenPair& pair : pairs) {
+        y.Axpy(-pair.value * pair.vector.Dot(x), pair.vector);
+      }
+
+      double value = x.Dot(y);
+      S21Vector residual(y);
+      residual.Axpy(-value, x);
+      if (residual.Norm() <= options.tolerance * std::fabs(value)) {
+        pairs.push_back({value, x});
+        converged = true;
+      } else {
+        y.Scale(1 / y.Norm());
+        x = std::move(y);
+      }
+    }
+    if (!converged) {
+      throw std::runtime_error(
+          "EigenError: The power iteration did not converge");
+    }
+  }
+
+  return pairs;
+}
+
+std::vector<S21EigenPair> LanczosEigen(const S21Matrix& matrix, int count,
+                                       const S21EigenOptions& options) {
+  S21TraceScope trace(S21TraceOp::kLanczosEigen, matrix.GetRows(),
+                      matrix.GetCols(), 0, 0, count);
+  CheckMatrix(matrix);
+  return LanczosEigen(MatrixOperator(matrix), matrix.GetRows(), count,
+                      options);
+}
+
+std::vector<S21EigenPair> LanczosEigen(const S21LinearOperator& matrix,
+                                       int size, int count,
+                                       const S21EigenOptions& options) {
+  CheckCount(size, count);
+  // replayed on a dense matrix of the size
+  S21TraceScope trace(S21TraceOp::kLanczosEigen, size, size, 0, 0, count);
+
+  std::vector<S21Vector> basis;
+  std::vector<double> alphas, betas;
+  std::vector<double> values, vectors;
+  std::vector<int> order;
+  double scale = 0;  // estimate of the operator norm
+  basis.push_back(RandomUnitVector(size, options.seed));
+  while (true) {
+    int steps = basis.size();
+    S21Vector w(size);
+    matrix(basis.back(), w);
+    alphas.push_back(basis.back().Dot(w));
+    Orthogonalize(w, basis);
+    double beta = w.Norm();
+    scale = std::max(scale, std::fabs(alphas.back()) + beta);
+
+    // a basis of the whole space makes the Ritz pairs exact
+    bool exhausted = steps == size;
+    if (!exhausted && beta <= kEpsilon * scale * std::sqrt(size)) {
+      // invariant subspace, the basis goes on with a fresh direction
+      beta = 0;
+      w = RandomUnitVector(size, options.seed + steps);
+      Orthogonalize(w, basis);
+      w.Scale(1 / w.Norm());
+    }
+
+    if (exhausted || (steps >= count &&
+                      (steps - count) % kLanczosCheckPeriod == 0 && beta)) {
+      values = alphas;
+      TridiagonalEigen(values, betas, vectors, true);
+      order.resize(steps);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(),
+                [&values](int a, int b) { return values[a] > values[b]; });
+
+      // the residual of a Ritz pair is beta times its last component
+      bool converged = true;
+      for (int i = 0; i < count && converged; i++) {
+        double last = vectors[order[i]];
+        converged = std::fabs(beta * last) <=
+                    options.tolerance * std::fabs(values[order[i]]);
+      }
+      if (exhausted || converged) {
+        break;
+      }
+    }
+
+    betas.push_back(beta);
+    if (beta) {
+      w.Scale(1 / beta);
+    }
+    basis.push_back(std::move(w));
+  }
+
+  int steps = basis.size();
+  values = alphas;
+  TridiagonalEigen(values, betas, vectors, false);
+  std::vector<S21EigenPair> pairs;
+  for (int i = 0; i < count; i++) {
+    S21Vector ritz(size);
+    for (int j = 0; j < steps; j++) {
+      ritz.Axpy(vectors[static_cast<std::size_t>(j) * steps + order[i]],
+                basis[j]);
+    }
+    ritz.Scale(1 / ritz.Norm());
+    pairs.push_back({values[order[i]], std::move(ritz)});
+  }
+
+  return pairs;
+}
+
+}  // namespace s_21
@@ -0,0 +1,65 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_EIGEN_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_EIGEN_H_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_vector.h"
+
+namespace s_21 {
+struct S21EigenPair {
+  double value;
+  S21Vector vector;  // unit length
+};
+
+struct S21EigenOptions {
+  // power iterations per eigenpair
+  int max_iterations = 1000;
+  // a pair is accepted once |A v - value v| <= tolerance * |value|
+  double tolerance = 1e-10;
+  // seed of the deterministic start vectors
+  std::uint64_t seed = 21;
+};
+
+// y = A x for a symmetric A that never has to be formed, y arrives zeroed
+using S21LinearOperator = std::function<void(const S21Vector& x, S21Vector& y)>;
+
+// Iterative eigensolvers for the few extreme eigenpairs of a symmetric
+// matrix. Each step costs one matrix-vector product, O(n^2) for a dense
+// matrix, instead of the O(n^3) of a full decomposition.
+
+/**
+ * Power iteration with Hotelling deflation, the count eigenpairs of the
+ * largest magnitude in the order they are found. Converges at the rate of
+ * the ratio of neighbouring magnitudes.
+ * @throws EigenError: The matrix must be square and symmetric, the count
+ * must be between 1 and the size, the power iteration did not converge
+ */
+std::vector<S21EigenPair> DominantEigen(
+    const S21Matrix& matrix, int count = 1,
+    const S21EigenOptions& options = S21EigenOptions());
+std::vector<S21EigenPair> DominantEigen(
+    const S21LinearOperator& matrix, int size, int count = 1,
+    const S21EigenOptions& options = S21EigenOptions());
+
+/**
+ * Lanczos iteration with full reorthogonalization, the count largest
+ * eigenpairs in descending order. Needs far fewer products than the power
+ * iteration when the eigenvalues are close; the Krylov basis takes
+ * O(steps * n) memory.
+ * @throws EigenError: The matrix must be square and symmetric, the count
+ * must be between 1 and the size
+ */
+std::vector<S21EigenPair> LanczosEigen(
+    const S21Matrix& matrix, int count = 1,
+    const S21EigenOptions& options = S21EigenOptions());
+std::vector<S21EigenPair> LanczosEigen(
+    const S21LinearOperator& matrix, int size, int count = 1,
+    const S21EigenOptions& options = S21EigenOptions());
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_EIGEN_H_
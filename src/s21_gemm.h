@@ -0,0 +1,70 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_GEMM_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_GEMM_H_
+
+#include <algorithm>
+
+#include "s21_thread_pool.h"
+
+namespace s_21 {
+// Dense product kernel shared by S21Matrix, S21MatrixChain and S21DiskMatrix.
+// Internal to the library, it is not installed with the public headers.
+
+enum class S21GemmUpdate { kAssign, kAccumulate };
+
+// below this many multiply-adds threads cost more than they save
+constexpr long kGemmParallelMultiplyAdds = 1L << 18;
+constexpr long kGemmChunkMultiplyAdds = 1L << 16;
+
+/**
+ * res = a * b or res += a * b for a rows x inner and b inner x cols. The
+ * operands are reached through row(i) functions returning the first value
+ * of row i, so permuted row pointers work as well as contiguous buffers.
+ * res must not overlap a or b. Large products are split into row blocks on
+ * the thread pool.
+ */
+template <typename ARow, typename BRow, typename ResRow>
+void Gemm(int rows, int inner, int cols, ARow a_row, BRow b_row,
+          ResRow res_row, S21GemmUpdate update) {
+  auto body = [=](int from, int to) {
+    // i-k-j order walks all three matrices along their rows
+    for (int i = from; i < to; i++) {
+      double* res_i = res_row(i);
+      const double* a_i = a_row(i);
+      if (update == S21GemmUpdate::kAssign) {
+        std::fill(res_i, res_i + cols, 0.0);
+      }
+      for (int k = 0; k < inner; k++) {
+        double a_ik = a_i[k];
+        const double* b_k = b_row(k);
+        for (int j = 0; j < cols; j++) {
+          res_i[j] += a_ik * b_k[j];
+        }
+      }
+    }
+  };
+
+  long row_work = std::max(1L, static_cast<long>(inner) * cols);
+  if (rows * row_work < kGemmParallelMultiplyAdds) {
+    body(0, rows);
+    return;
+  }
+
+  int grain = std::max(1L, kGemmChunkMultiplyAdds / row_work);
+  S21ThreadPool::Instance().ParallelFor(0, rows, grain, body);
+}
+
+// contiguous row-major buffers
+inline void Gemm(const double* a, const double* b, double* res, int rows,
+                 int inner, int cols, S21GemmUpdate update) {
+  Gemm(
+      rows, inner, cols,
+      [a, inner](int i) { return a + static_cast<long>(i) * inner; },
+      [b, cols](int k) { return b + static_cast<long>(k) * cols; },
+      [res, cols](int i) { return res + static_cast<long>(i) * cols; },
+      update);
+}
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_GEMM_H_
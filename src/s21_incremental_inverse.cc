@@ -0,0 +1,231 @@
+#include "s21_incremental_inverse.h"
+
+#include "s21_trace.h"
+
+namespace s_21 {
+namespace {
+// smaller Sherman-Morrison denominators lose too many digits to cancellation,
+// the inverse is recomputed from scratch instead
+constexpr double kMinDenominator = 1e-10;
+// the Schur complement has the units of the matrix values, so it is compared
+// with the terms it is the difference of
+constexpr double kMinRelativeSchur = 1e-10;
+}  // namespace
+
+// CONSTRUCTORS
+
+S21IncrementalInverse::S21IncrementalInverse(const S21Matrix& matrix,
+                                             int refactor_period)
+    : matrix_(matrix),
+      inverse_(1, 1),
+      determinant_(0),
+      refactor_period_(refactor_period),
+      updates_count_(0) {
+  if (refactor_period <= 0) {
+    throw std::invalid_argument(
+        "IncrementalInverseError: The period cannot be less than 1");
+  }
+  if (!matrix_.IsMatrixSquare() || matrix_.rows_ <= 0) {
+    throw std::range_error(
+        "IncrementalInverseError: The matrix must be square");
+  }
+  // the updates write into the storage directly
+  matrix_.SetCopyOnWrite(false);
+  if (!Decompose()) {
+    throw std::range_error("IncrementalInverseError: The matrix is singular");
+  }
+}
+
+// GETTERS
+
+int S21IncrementalInverse::GetSize() const { return matrix_.rows_; }
+
+const S21Matrix& S21IncrementalInverse::GetMatrix() const { return matrix_; }
+
+const S21Matrix& S21IncrementalInverse::GetInverse() const { return inverse_; }
+
+double S21IncrementalInverse::GetDeterminant() const { return determinant_; }
+
+int S21IncrementalInverse::GetRefactorPeriod() const {
+  return refactor_period_;
+}
+
+// MEMBER FUNCTIONS
+
+void S21IncrementalInverse::RankOneUpdate(const S21Vector& u,
+                                          const S21Vector& v) {
+  int size = matrix_.rows_;
+  S21TraceScope trace(S21TraceOp::kRankOneUpdate, size, size);
+  if (u.GetSize() != size || v.GetSize() != size) {
+    throw std::range_error("UpdateError: Incorrect dimensions of the vectors");
+  }
+
+  Update(u, v, [&] { AddOuterProduct(matrix_, &u(0), &v(0), 1); });
+}
+
+void S21IncrementalInverse::ReplaceRow(int row, const S21Vector& values) {
+  int size = matrix_.rows_;
+  S21TraceScope trace(S21TraceOp::kReplaceRow, size, size);
+  if (row < 0 || row >= size) {
+    throw std::out_of_range("UpdateError: The row is out of range");
+  }
+  if (values.GetSize() != size) {
+    throw std::range_error("UpdateError: Incorrect dimensions of the vectors");
+  }
+
+  S21Vector u(size);
+  S21Vector v(values);
+  u(row) = 1;
+  for (int j = 0; j < size; j++) {
+    v(j) -= matrix_.matrix_[row][j];
+  }
+  // old + (new - old) may differ from new in the last bit
+  Update(u, v, [&] {
+    std::memcpy(matrix_.matrix_[row], &values(0), size * sizeof(double));
+  });
+}
+
+void S21IncrementalInverse::ReplaceCol(int col, const S21Vector& values) {
+  int size = matrix_.rows_;
+  S21TraceScope trace(S21TraceOp::kReplaceCol, size, size);
+  if (col < 0 || col >= size) {
+    throw std::out_of_range("UpdateError: The col is out of range");
+  }
+  if (values.GetSize() != size) {
+    throw std::range_error("UpdateError: Incorrect dimensions of the vectors");
+  }
+
+  S21Vector u(values);
+  S21Vector v(size);
+  v(col) = 1;
+  for (int i = 0; i < size; i++) {
+    u(i) -= matrix_.matrix_[i][col];
+  }
+  Update(u, v, [&] {
+    for (int i = 0; i < size; i++) {
+      matrix_.matrix_[i][col] = values(i);
+    }
+  });
+}
+
+void S21IncrementalInverse::AppendRowCol(const S21Vector& row,
+                                         const S21Vector& col, double corner) {
+  int size = matrix_.rows_;
+  S21TraceScope trace(S21TraceOp::kAppendRowCol, size, size);
+  if (row.GetSize() != size || col.GetSize() != size) {
+    throw std::range_error("UpdateError: Incorrect dimensions of the vectors");
+  }
+
+  S21Matrix bordered(size + 1, size + 1);
+  for (int i = 0; i < size; i++) {
+    std::memcpy(bordered.matrix_[i], matrix_.matrix_[i], size * sizeof(double));
+    bordered.matrix_[i][size] = col(i);
+    bordered.matrix_[size][i] = row(i);
+  }
+  bordered.matrix_[size][size] = corner;
+
+  // Schur complement of the old matrix in the bordered one
+  S21Vector b_col = inverse_ * col;
+  S21Vector row_b(size);
+  inverse_.Gevm(1, row, 0, row_b);
+  double schur = corner - row.Dot(b_col);
+
+  double scale = std::fabs(corner) + row.Norm() * b_col.Norm();
+  if (std::fabs(schur) <= kMinRelativeSchur * scale || IsRefactorDue()) {
+    std::swap(matrix_, bordered);
+    if (!Decompose()) {
+      std::swap(matrix_, bordered);
+      throw std::range_error("UpdateError: The bordered matrix is singular");
+    }
+    return;
+  }
+
+  S21Matrix inverse(size + 1, size + 1);
+  for (int i = 0; i < size; i++) {
+    double factor = b_col(i) / schur;
+    const double* b_row = inverse_.matrix_[i];
+    double* res_row = inverse.matrix_[i];
+    for (int j = 0; j < size; j++) {
+      res_row[j] = b_row[j] + factor * row_b(j);
+    }
+    res_row[size] = -factor;
+    inverse.matrix_[size][i] = -row_b(i) / schur;
+  }
+  inverse.matrix_[size][size] = 1 / schur;
+
+  matrix_ = std::move(bordered);
+  inverse_ = std::move(inverse);
+  determinant_ *= schur;
+  updates_count_++;
+}
+
+void S21IncrementalInverse::Refactorize() {
+  if (!Decompose()) {
+    throw std::range_error("UpdateError: The matrix is singular");
+  }
+}
+
+// PRIVATE MEMBER FUNCTIONS
+
+bool S21IncrementalInverse::Decompose() {
+  int size = matrix_.rows_;
+  S21Matrix lu(size, size);
+  std::vector<int> pivots;
+  int sign = matrix_.Factorize(lu, pivots);
+  if (!sign) {
+    return false;
+  }
+
+  S21Matrix identity(size, size);
+  identity.SetIdentity();
+  inverse_ = S21Matrix::SolveFactorized(lu, pivots, identity);
+  determinant_ = sign;
+  for (int i = 0; i < size; i++) {
+    determinant_ *= lu.matrix_[i][i];
+  }
+  updates_count_ = 0;
+
+  return true;
+}
+
+void S21IncrementalInverse::Update(const S21Vector& u, const S21Vector& v,
+                                   const std::function<void()>& write) {
+  int size = matrix_.rows_;
+  // (A + u v^T)^-1 = B - (B u)(v^T B) / (1 + v^T B u)
+  S21Vector b_u = inverse_ * u;
+  S21Vector v_b(size);
+  inverse_.Gevm(1, v, 0, v_b);
+  double denominator = 1 + v.Dot(b_u);
+
+  if (std::fabs(denominator) < kMinDenominator || IsRefactorDue()) {
+    S21Matrix previous(matrix_);
+    write();
+    if (!Decompose()) {
+      matrix_ = std::move(previous);
+      throw std::range_error("UpdateError: The updated matrix is singular");
+    }
+    return;
+  }
+
+  write();
+  AddOuterProduct(inverse_, &b_u(0), &v_b(0), -1 / denominator);
+  determinant_ *= denominator;
+  updates_count_++;
+}
+
+bool S21IncrementalInverse::IsRefactorDue() const {
+  return updates_count_ + 1 >= refactor_period_;
+}
+
+void S21IncrementalInverse::AddOuterProduct(S21Matrix& matrix, const double* u,
+                                            const double* v, double scale) {
+  for (int i = 0; i < matrix.rows_; i++) {
+    double factor = scale * u[i];
+    double* row = matrix.matrix_[i];
+    for (int j = 0; j < matrix.cols_; j++) {
+      row[j] += factor * v[j];
+    }
+  }
+}
+
+}  // namespace s_21
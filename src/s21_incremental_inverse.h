@@ -0,0 +1,88 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_INCREMENTAL_INVERSE_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_INCREMENTAL_INVERSE_H_
+
+#include <functional>
+
+#include "s21_matrix_oop.h"
+#include "s21_vector.h"
+
+namespace s_21 {
+// Keeps the inverse and the determinant of a matrix up to date under low rank
+// changes in O(n^2) per change instead of a new O(n^3) decomposition
+class S21IncrementalInverse {
+ public:
+  // Constructors
+
+  /**
+   * Decomposes the matrix once. Every refactor_period updates the inverse and
+   * the determinant are recomputed from scratch to drop accumulated rounding.
+   * @throws IncrementalInverseError: The matrix must be square and
+   * non-singular, the period cannot be less than 1
+   */
+  explicit S21IncrementalInverse(const S21Matrix& matrix,
+                                 int refactor_period = 64);
+
+  // Getters
+
+  int GetSize() const;
+  const S21Matrix& GetMatrix() const;
+  const S21Matrix& GetInverse() const;
+  double GetDeterminant() const;
+  int GetRefactorPeriod() const;
+
+  // Member functions
+
+  /**
+   * matrix += u * v^T (Sherman-Morrison and the matrix determinant lemma)
+   * @throws UpdateError: Incorrect dimensions of the vectors or the updated
+   * matrix is singular, the object is left unchanged then
+   */
+  void RankOneUpdate(const S21Vector& u, const S21Vector& v);
+  /**
+   * @throws UpdateError: see RankOneUpdate, or the row is out of range
+   */
+  void ReplaceRow(int row, const S21Vector& values);
+  /**
+   * @throws UpdateError: see RankOneUpdate, or the col is out of range
+   */
+  void ReplaceCol(int col, const S21Vector& values);
+  /**
+   * Borders the matrix with a new last row and col. Both vectors hold the n
+   * current values, corner is the new diagonal value.
+   * @throws UpdateError: Incorrect dimensions of the vectors or the bordered
+   * matrix is singular, the object is left unchanged then
+   */
+  void AppendRowCol(const S21Vector& row, const S21Vector& col, double corner);
+  /**
+   * Recomputes the inverse and the determinant by LU decomposition
+   * @throws UpdateError: The matrix is singular
+   */
+  void Refactorize();
+
+ private:
+  S21Matrix matrix_;
+  S21Matrix inverse_;
+  double determinant_;
+  int refactor_period_;
+  int updates_count_;
+
+  bool Decompose();
+  /**
+   * matrix += u * v^T, where write stores the exact new values of the matrix.
+   * The inverse is updated by Sherman-Morrison, or decomposed again from the
+   * written values when the denominator is too small or the refactor period
+   * is over; a singular result restores the matrix before throwing.
+   */
+  void Update(const S21Vector& u, const S21Vector& v,
+              const std::function<void()>& write);
+  // the next update is the last one of the refactor period
+  bool IsRefactorDue() const;
+  // matrix += scale * u * v^T
+  static void AddOuterProduct(S21Matrix& matrix, const double* u,
+                              const double* v, double scale);
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_INCREMENTAL_INVERSE_H_
@@ -0,0 +1,67 @@
+#include "s21_matrix_async.h"
+
+namespace s_21 {
+namespace async {
+// MATRIX OPERATIONS
+
+Future<S21Matrix> Sum(const Future<S21Matrix>& a, const Future<S21Matrix>& b) {
+  return Run(
+      [](const S21Matrix& lhs, const S21Matrix& rhs) {
+        S21Matrix res_matrix(lhs);
+        res_matrix.SumMatrix(rhs);
+        return res_matrix;
+      },
+      a, b);
+}
+
+Future<S21Matrix> Sub(const Future<S21Matrix>& a, const Future<S21Matrix>& b) {
+  return Run(
+      [](const S21Matrix& lhs, const S21Matrix& rhs) {
+        S21Matrix res_matrix(lhs);
+        res_matrix.SubMatrix(rhs);
+        return res_matrix;
+      },
+      a, b);
+}
+
+Future<S21Matrix> Mul(const Future<S21Matrix>& a, const Future<S21Matrix>& b) {
+  return Run(
+      [](const S21Matrix& lhs, const S21Matrix& rhs) {
+        S21Matrix res_matrix(lhs);
+        res_matrix.MulMatrix(rhs);
+        return res_matrix;
+      },
+      a, b);
+}
+
+Future<S21Matrix> Mul(const Future<S21Matrix>& a, double num) {
+  return a.Then([num](const S21Matrix& matrix) { return matrix * num; });
+}
+
+Future<S21Matrix> Transpose(const Future<S21Matrix>& a) {
+  return a.Then([](const S21Matrix& matrix) { return matrix.Transpose(); });
+}
+
+Future<S21Matrix> CalcComplements(const Future<S21Matrix>& a) {
+  return a.Then(
+      [](const S21Matrix& matrix) { return matrix.CalcComplements(); });
+}
+
+Future<double> Determinant(const Future<S21Matrix>& a) {
+  return a.Then([](const S21Matrix& matrix) { return matrix.Determinant(); });
+}
+
+Future<S21Matrix> Inverse(const Future<S21Matrix>& a) {
+  return a.Then(
+      [](const S21Matrix& matrix) { return matrix.InverseMatrix(); });
+}
+
+Future<S21Matrix> Solve(const Future<S21Matrix>& a,
+                        const Future<S21Matrix>& b) {
+  return Run([](const S21Matrix& lhs,
+                const S21Matrix& rhs) { return lhs.Solve(rhs); },
+             a, b);
+}
+
+}  // namespace async
+}  // namespace s_21
@@ -0,0 +1,239 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_ASYNC_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_ASYNC_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
+
+#include "s21_matrix_oop.h"
+#include "s21_thread_pool.h"
+
+namespace s_21 {
+namespace async {
+namespace internal {
+// Result slot shared between a future and the task producing it
+template <typename T>
+class SharedState {
+ public:
+  void SetValue(T value) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      value_.emplace(std::move(value));
+    }
+    Finish();
+  }
+
+  void SetError(std::exception_ptr error) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = error;
+    }
+    Finish();
+  }
+
+  /**
+   * Runs the callback once the result is ready (immediately if it already is)
+   */
+  void OnReady(std::function<void()> callback) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!ready_) {
+        callbacks_.push_back(std::move(callback));
+        return;
+      }
+    }
+    callback();
+  }
+
+  bool IsReady() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ready_;
+  }
+
+  void Wait() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_cv_.wait(lock, [this] { return ready_; });
+  }
+
+  // the result never changes once ready, so it is read without the lock
+  const T& Get() const {
+    Wait();
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return *value_;
+  }
+
+  std::exception_ptr GetError() const {
+    Wait();
+    return error_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  mutable std::condition_variable ready_cv_;
+  bool ready_ = false;
+  std::optional<T> value_;
+  std::exception_ptr error_;
+  std::vector<std::function<void()>> callbacks_;
+
+  void Finish() {
+    std::vector<std::function<void()>> callbacks;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ready_ = true;
+      callbacks.swap(callbacks_);
+    }
+    ready_cv_.notify_all();
+    for (std::function<void()>& callback : callbacks) {
+      callback();
+    }
+  }
+};
+}  // namespace internal
+
+template <typename T>
+class Future;
+
+template <typename F, typename... Args>
+Future<std::invoke_result_t<F, const Args&...>> Run(
+    F function, const Future<Args>&... inputs);
+
+/**
+ * Handle to the result of an asynchronous operation. Copies refer to the same
+ * result, so one future may feed any number of dependent operations.
+ */
+template <typename T>
+class Future {
+ public:
+  /**
+   * Wraps an already known value into a ready future
+   */
+  Future(T value) : Future() { state_->SetValue(std::move(value)); }
+
+  bool IsReady() const { return state_->IsReady(); }
+  void Wait() const { state_->Wait(); }
+  /**
+   * Blocks until the result is ready. Must not be called from a pool task.
+   * @throws Rethrows the exception of the operation or of its inputs
+   */
+  const T& Get() const { return state_->Get(); }
+
+  /**
+   * Schedules function(result) as soon as this future is ready
+   */
+  template <typename F>
+  Future<std::invoke_result_t<F, const T&>> Then(F function) const {
+    return Run(std::move(function), *this);
+  }
+
+#if defined(__cpp_impl_coroutine)
+  // Lets a C++20 coroutine co_await the result without blocking a thread
+  auto operator co_await() const {
+    struct Awaiter {
+      std::shared_ptr<internal::SharedState<T>> state;
+
+      bool await_ready() const { return state->IsReady(); }
+      void await_suspend(std::coroutine_handle<> handle) const {
+        state->OnReady([handle] { handle.resume(); });
+      }
+      const T& await_resume() const { return state->Get(); }
+    };
+    return Awaiter{state_};
+  }
+#endif
+
+ private:
+  std::shared_ptr<internal::SharedState<T>> state_;
+
+  Future() : state_(std::make_shared<internal::SharedState<T>>()) {}
+
+  template <typename U>
+  friend class Future;
+  template <typename F, typename... Args>
+  friend Future<std::invoke_result_t<F, const Args&...>> Run(
+      F function, const Future<Args>&... inputs);
+};
+
+/**
+ * Schedules function(inputs...) on the library thread pool as soon as all
+ * inputs are ready, so chained calls form a dependency graph: independent
+ * nodes run in parallel and no worker is blocked waiting for an input.
+ * An exception of any input is passed on to the result.
+ */
+template <typename F, typename... Args>
+Future<std::invoke_result_t<F, const Args&...>> Run(
+    F function, const Future<Args>&... inputs) {
+  using Result = std::invoke_result_t<F, const Args&...>;
+  Future<Result> result;
+
+  auto task = [state = result.state_, function = std::move(function),
+               inputs = std::make_tuple(inputs.state_...)]() mutable {
+    try {
+      std::exception_ptr error;
+      std::apply(
+          [&error](const auto&... input) {
+            ((error = error ? error : input->GetError()), ...);
+          },
+          inputs);
+      if (error) {
+        state->SetError(error);
+      } else {
+        state->SetValue(std::apply(
+            [&function](const auto&... input) {
+              return function(input->Get()...);
+            },
+            inputs));
+      }
+    } catch (...) {
+      state->SetError(std::current_exception());
+    }
+  };
+
+  if constexpr (sizeof...(Args) == 0) {
+    S21ThreadPool::Instance().Submit(std::move(task));
+  } else {
+    auto pending = std::make_shared<std::atomic<int>>(sizeof...(Args));
+    auto shared_task =
+        std::make_shared<std::function<void()>>(std::move(task));
+    auto on_input_ready = [pending, shared_task] {
+      if (pending->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        S21ThreadPool::Instance().Submit(std::move(*shared_task));
+      }
+    };
+    (inputs.state_->OnReady(on_input_ready), ...);
+  }
+
+  return result;
+}
+
+// Matrix operations
+
+Future<S21Matrix> Sum(const Future<S21Matrix>& a, const Future<S21Matrix>& b);
+Future<S21Matrix> Sub(const Future<S21Matrix>& a, const Future<S21Matrix>& b);
+Future<S21Matrix> Mul(const Future<S21Matrix>& a, const Future<S21Matrix>& b);
+Future<S21Matrix> Mul(const Future<S21Matrix>& a, double num);
+Future<S21Matrix> Transpose(const Future<S21Matrix>& a);
+Future<S21Matrix> CalcComplements(const Future<S21Matrix>& a);
+Future<double> Determinant(const Future<S21Matrix>& a);
+Future<S21Matrix> Inverse(const Future<S21Matrix>& a);
+Future<S21Matrix> Solve(const Future<S21Matrix>& a, const Future<S21Matrix>& b);
+
+}  // namespace async
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_ASYNC_H_
@@ -0,0 +1,210 @@
+#include "s21_matrix_cache.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace s_21 {
+namespace {
+constexpr std::uint64_t kLanePrime = 0x9E3779B97F4A7C15ULL;
+
+std::uint64_t Mix(std::uint64_t lane, double value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  lane = (lane ^ bits) * kLanePrime;
+  return lane ^ (lane >> 29);
+}
+
+// splitmix64 finalizer
+std::uint64_t Finalize(std::uint64_t hash) {
+  hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+  return hash ^ (hash >> 31);
+}
+}  // namespace
+
+// CONSTRUCTORS
+
+S21MatrixCache::S21MatrixCache(int capacity, int shards_count)
+    : shard_capacity_(0), hits_(0), misses_(0), evictions_(0) {
+  if (capacity <= 0 || shards_count <= 0) {
+    throw std::invalid_argument(
+        "CreationError: The capacity and the number of shards cannot be less "
+        "than 1");
+  }
+
+  shards_count = std::min(shards_count, capacity);
+  shard_capacity_ = (capacity + shards_count - 1) / shards_count;
+  for (int i = 0; i < shards_count; i++) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+}
+
+// GETTERS
+
+S21MatrixCache::Stats S21MatrixCache::GetStats() const {
+  return {hits_.load(), misses_.load(), evictions_.load()};
+}
+
+int S21MatrixCache::GetSize() const {
+  int size = 0;
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    size += shard->entries.size();
+  }
+
+  return size;
+}
+
+// MEMBER FUNCTIONS
+
+double S21MatrixCache::Determinant(const S21Matrix& matrix) {
+  std::uint64_t hash = KeyHash(matrix, Operation::kDeterminant);
+  Shard& shard = GetShard(hash);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (Entry* entry = Find(shard, hash, Operation::kDeterminant, matrix)) {
+      hits_++;
+      return entry->number_result;
+    }
+  }
+
+  // computed outside the lock, a concurrent miss on the same key only
+  // duplicates the work
+  misses_++;
+  double det = matrix.Determinant();
+  Insert(shard,
+         Entry{hash, Operation::kDeterminant, matrix, std::nullopt, det});
+
+  return det;
+}
+
+S21Matrix S21MatrixCache::InverseMatrix(const S21Matrix& matrix) {
+  return CachedMatrix(matrix, Operation::kInverse, &S21Matrix::InverseMatrix);
+}
+
+S21Matrix S21MatrixCache::CalcComplements(const S21Matrix& matrix) {
+  return CachedMatrix(matrix, Operation::kComplements,
+                      &S21Matrix::CalcComplements);
+}
+
+void S21MatrixCache::Clear() {
+  for (std::unique_ptr<Shard>& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->index.clear();
+    shard->entries.clear();
+  }
+}
+
+std::uint64_t S21MatrixCache::Hash(const S21Matrix& matrix) {
+  std::uint64_t lanes[4] = {1, 2, 3, 4};
+  for (int i = 0; i < matrix.rows_; i++) {
+    const double* row = matrix.matrix_[i];
+    int j = 0;
+    for (; j + 4 <= matrix.cols_; j += 4) {
+      for (int lane = 0; lane < 4; lane++) {
+        lanes[lane] = Mix(lanes[lane], row[j + lane]);
+      }
+    }
+    for (; j < matrix.cols_; j++) {
+      lanes[0] = Mix(lanes[0], row[j]);
+    }
+  }
+
+  std::uint64_t hash = static_cast<std::uint64_t>(matrix.rows_) << 32 |
+                       static_cast<std::uint32_t>(matrix.cols_);
+  for (std::uint64_t lane : lanes) {
+    hash = Finalize(hash ^ lane);
+  }
+
+  return hash;
+}
+
+// PRIVATE MEMBER FUNCTIONS
+
+std::uint64_t S21MatrixCache::KeyHash(const S21Matrix& matrix,
+                                      Operation operation) {
+  // results of different operations on one matrix go to different shards
+  return Finalize(Hash(matrix) + static_cast<std::uint64_t>(operation));
+}
+
+S21MatrixCache::Shard& S21MatrixCache::GetShard(std::uint64_t hash) {
+  // the low bits pick the bucket inside the shard map
+  return *shards_[(hash >> 48) % shards_.size()];
+}
+
+S21Matrix S21MatrixCache::CachedMatrix(const S21Matrix& matrix,
+                                       Operation operation,
+                                       S21Matrix (S21Matrix::*compute)()
+                                           const) {
+  std::uint64_t hash = KeyHash(matrix, operation);
+  Shard& shard = GetShard(hash);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (Entry* entry = Find(shard, hash, operation, matrix)) {
+      hits_++;
+      return *entry->matrix_result;
+    }
+  }
+
+  misses_++;
+  S21Matrix result = (matrix.*compute)();
+  result.SetCopyOnWrite(true);
+  Insert(shard, Entry{hash, operation, matrix, result, 0});
+
+  return result;
+}
+
+S21MatrixCache::Entry* S21MatrixCache::Find(Shard& shard, std::uint64_t hash,
+                                            Operation operation,
+                                            const S21Matrix& matrix) {
+  auto range = shard.index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    std::list<Entry>::iterator entry = it->second;
+    if (entry->operation == operation && IsIdentical(entry->key, matrix)) {
+      shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+      return &*entry;
+    }
+  }
+
+  return nullptr;
+}
+
+void S21MatrixCache::Insert(Shard& shard, Entry entry) {
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (Find(shard, entry.hash, entry.operation, entry.key)) {
+    return;
+  }
+
+  std::uint64_t hash = entry.hash;
+  shard.entries.push_front(std::move(entry));
+  shard.index.emplace(hash, shard.entries.begin());
+  if (static_cast<int>(shard.entries.size()) > shard_capacity_) {
+    std::list<Entry>::iterator oldest = std::prev(shard.entries.end());
+    auto range = shard.index.equal_range(oldest->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == oldest) {
+        shard.index.erase(it);
+        break;
+      }
+    }
+    shard.entries.erase(oldest);
+    evictions_++;
+  }
+}
+
+bool S21MatrixCache::IsIdentical(const S21Matrix& a, const S21Matrix& b) {
+  if (a.rows_ != b.rows_ || a.cols_ != b.cols_) {
+    return false;
+  }
+
+  for (int i = 0; i < a.rows_; i++) {
+    if (std::memcmp(a.matrix_[i], b.matrix_[i], a.cols_ * sizeof(double))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace s_21
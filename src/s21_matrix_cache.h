@@ -0,0 +1,105 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_CACHE_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s_21 {
+// Bounded LRU memo of Determinant, InverseMatrix and CalcComplements keyed by
+// the matrix content. A lookup costs one pass of hashing over the values plus
+// an exact comparison with the stored input. Safe to share between threads.
+class S21MatrixCache {
+ public:
+  struct Stats {
+    std::uint64_t hits;
+    std::uint64_t misses;
+    std::uint64_t evictions;
+  };
+
+  // Constructors
+
+  /**
+   * The capacity is split evenly between shards_count independently locked
+   * shards, each shard evicts its own least recently used entry
+   * @throws CreationError: The capacity and the number of shards cannot be
+   * less than 1
+   */
+  explicit S21MatrixCache(int capacity, int shards_count = 16);
+  S21MatrixCache(const S21MatrixCache& other) = delete;
+  S21MatrixCache& operator=(const S21MatrixCache& other) = delete;
+
+  // Getters
+
+  Stats GetStats() const;
+  int GetSize() const;
+
+  // Member functions
+
+  /**
+   * @throws DeterminantError: The matrix must be square
+   */
+  double Determinant(const S21Matrix& matrix);
+  /**
+   * The result shares its storage with the cache entry (copy-on-write)
+   * @throws InverseError: Incompatible matrix sizes to search inverse matrix
+   */
+  S21Matrix InverseMatrix(const S21Matrix& matrix);
+  /**
+   * The result shares its storage with the cache entry (copy-on-write)
+   * @throws CalcComplementsError: The matrix must be square
+   */
+  S21Matrix CalcComplements(const S21Matrix& matrix);
+  void Clear();
+
+  /**
+   * Content hash of the dimensions and the values, bitwise equal matrices have
+   * equal hashes. Four independent lanes keep the multiplier units busy.
+   */
+  static std::uint64_t Hash(const S21Matrix& matrix);
+
+ private:
+  enum class Operation { kDeterminant, kInverse, kComplements };
+
+  struct Entry {
+    std::uint64_t hash;
+    Operation operation;
+    S21Matrix key;
+    std::optional<S21Matrix> matrix_result;
+    double number_result;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::list<Entry> entries;  // most recently used first
+    std::unordered_multimap<std::uint64_t, std::list<Entry>::iterator> index;
+  };
+
+  int shard_capacity_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<std::uint64_t> hits_;
+  std::atomic<std::uint64_t> misses_;
+  std::atomic<std::uint64_t> evictions_;
+
+  static std::uint64_t KeyHash(const S21Matrix& matrix, Operation operation);
+  Shard& GetShard(std::uint64_t hash);
+  S21Matrix CachedMatrix(const S21Matrix& matrix, Operation operation,
+                         S21Matrix (S21Matrix::*compute)() const);
+  // moves a found entry to the front, the shard must be locked
+  Entry* Find(Shard& shard, std::uint64_t hash, Operation operation,
+              const S21Matrix& matrix);
+  void Insert(Shard& shard, Entry entry);
+  static bool IsIdentical(const S21Matrix& a, const S21Matrix& b);
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_CACHE_H_
@@ -0,0 +1,172 @@
+#include "s21_matrix_chain.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "s21_gemm.h"
+
+namespace s_21 {
+// intermediate products of one evaluation
+class S21MatrixChain::BufferPool {
+ public:
+  int Acquire(std::size_t size) {
+    // the tightest free buffer that fits, otherwise the largest one grows
+    int tightest = -1, largest = -1;
+    for (int i = 0; i < static_cast<int>(buffers_.size()); i++) {
+      if (!free_[i]) {
+        continue;
+      }
+      std::size_t capacity = buffers_[i].capacity();
+      if (capacity >= size &&
+          (tightest < 0 || capacity < buffers_[tightest].capacity())) {
+        tightest = i;
+      }
+      if (largest < 0 || capacity > buffers_[largest].capacity()) {
+        largest = i;
+      }
+    }
+
+    int best = tightest >= 0 ? tightest : largest;
+    if (best < 0) {
+      best = buffers_.size();
+      buffers_.emplace_back();
+      free_.push_back(true);
+    }
+
+    free_[best] = false;
+    buffers_[best].resize(size);
+    return best;
+  }
+
+  double* Data(int index) { return buffers_[index].data(); }
+
+  void Release(int index) {
+    if (index >= 0) {
+      free_[index] = true;
+    }
+  }
+
+ private:
+  std::vector<std::vector<double>> buffers_;
+  std::vector<bool> free_;
+};
+
+struct S21MatrixChain::Operand {
+  const double* data;
+  int rows, cols;
+  int buffer;  // -1 for a factor of the chain
+};
+
+// CONSTRUCTORS
+
+S21MatrixChain::S21MatrixChain(Factors factors)
+    : factors_(std::move(factors)), cost_(0) {
+  if (factors_.empty()) {
+    throw std::invalid_argument("MulMatrixError: The chain cannot be empty");
+  }
+
+  int count = factors_.size();
+  dims_.push_back(factors_[0].get().GetRows());
+  for (const S21Matrix& factor : factors_) {
+    if (factor.GetRows() != dims_.back()) {
+      throw std::range_error(
+          "MulMatrixError: Incorrect dimensions to multiply two matrices");
+    }
+    dims_.push_back(factor.GetCols());
+  }
+
+  // costs[first][last] is the cheapest product of factors first..last
+  std::vector<std::vector<double>> costs(count, std::vector<double>(count, 0));
+  splits_.assign(count, std::vector<int>(count, 0));
+  for (int length = 2; length <= count; length++) {
+    for (int first = 0; first + length <= count; first++) {
+      int last = first + length - 1;
+      costs[first][last] = std::numeric_limits<double>::infinity();
+      for (int split = first; split < last; split++) {
+        double cost = costs[first][split] + costs[split + 1][last] +
+                      2.0 * dims_[first] * dims_[split + 1] * dims_[last + 1];
+        if (cost < costs[first][last]) {
+          costs[first][last] = cost;
+          splits_[first][last] = split;
+        }
+      }
+    }
+  }
+  cost_ = costs[0][count - 1];
+}
+
+// GETTERS
+
+double S21MatrixChain::GetCost() const { return cost_; }
+
+double S21MatrixChain::GetLeftToRightCost() const {
+  double cost = 0;
+  for (int i = 2; i < static_cast<int>(dims_.size()); i++) {
+    cost += 2.0 * dims_[0] * dims_[i - 1] * dims_[i];
+  }
+
+  return cost;
+}
+
+std::string S21MatrixChain::GetPlan() const {
+  return PlanOf(0, factors_.size() - 1);
+}
+
+// MEMBER FUNCTIONS
+
+S21Matrix S21MatrixChain::Multiply() const {
+  if (factors_.size() == 1) {
+    return factors_[0].get();
+  }
+
+  S21Matrix result(dims_.front(), dims_.back());
+  BufferPool pool;
+  Evaluate(0, factors_.size() - 1, pool, result.begin());
+
+  return result;
+}
+
+S21Matrix MultiplyChain(S21MatrixChain::Factors factors) {
+  return S21MatrixChain(std::move(factors)).Multiply();
+}
+
+// PRIVATE MEMBER FUNCTIONS
+
+std::string S21MatrixChain::PlanOf(int first, int last) const {
+  if (first == last) {
+    return "A" + std::to_string(first);
+  }
+
+  int split = splits_[first][last];
+  return "(" + PlanOf(first, split) + " " + PlanOf(split + 1, last) + ")";
+}
+
+S21MatrixChain::Operand S21MatrixChain::Evaluate(int first, int last,
+                                                 BufferPool& pool,
+                                                 double* result) const {
+  if (first == last) {
+    const S21Matrix& factor = factors_[first];
+    return {factor.begin(), factor.GetRows(), factor.GetCols(), -1};
+  }
+
+  int split = splits_[first][last];
+  Operand left = Evaluate(first, split, pool, nullptr);
+  Operand right = Evaluate(split + 1, last, pool, nullptr);
+
+  int rows = dims_[first], cols = dims_[last + 1];
+  int buffer = -1;
+  if (!result) {
+    buffer = pool.Acquire(static_cast<std::size_t>(rows) * cols);
+    result = pool.Data(buffer);
+  }
+  Gemm(left.data, right.data, result, rows, left.cols, cols,
+       S21GemmUpdate::kAssign);
+  // both operands are consumed, their buffers serve the next products
+  pool.Release(left.buffer);
+  pool.Release(right.buffer);
+
+  return {result, rows, cols, buffer};
+}
+
+}  // namespace s_21
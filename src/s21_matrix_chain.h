@@ -0,0 +1,74 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_CHAIN_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_CHAIN_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s_21 {
+// Product of a chain of matrices in the cheapest order. The order is chosen by
+// dynamic programming over the shapes in O(n^3) of the chain length, which is
+// nothing next to the multiplications it saves on chains of mixed shapes.
+class S21MatrixChain {
+ public:
+  using Factors = std::vector<std::reference_wrapper<const S21Matrix>>;
+
+  // Constructors
+
+  /**
+   * Plans the product of the factors, they must outlive the chain
+   * @throws MulMatrixError: The chain cannot be empty, incorrect dimensions
+   * to multiply two matrices
+   */
+  explicit S21MatrixChain(Factors factors);
+
+  // Getters
+
+  /**
+   * Floating point operations of the planned order, 2 per multiply-add
+   */
+  double GetCost() const;
+  /**
+   * Floating point operations of the left to right order of operator*
+   */
+  double GetLeftToRightCost() const;
+  /**
+   * Parenthesization of the planned order, the factors are named by their
+   * position, e.g. "(A0 (A1 A2))"
+   */
+  std::string GetPlan() const;
+
+  // Member functions
+
+  /**
+   * Evaluates the planned order. Intermediate products live in a small pool
+   * of buffers that are reused as soon as their product is consumed.
+   */
+  S21Matrix Multiply() const;
+
+ private:
+  class BufferPool;
+  struct Operand;
+
+  Factors factors_;
+  std::vector<int> dims_;  // factor i is dims_[i] x dims_[i + 1]
+  std::vector<std::vector<int>> splits_;
+  double cost_;
+
+  std::string PlanOf(int first, int last) const;
+  Operand Evaluate(int first, int last, BufferPool& pool,
+                   double* result) const;
+};
+
+/**
+ * MultiplyChain({a, b, c}) is a * b * c evaluated in the cheapest order
+ * @throws MulMatrixError: see S21MatrixChain
+ */
+S21Matrix MultiplyChain(S21MatrixChain::Factors factors);
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_CHAIN_H_
@@ -1,41 +1,342 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "s21_gemm.h"
+#include "s21_thread_pool.h"
+#include "s21_trace.h"
+#include "s21_vector.h"
+
 namespace s_21 {
-// CONSTRUCTORS
+namespace {
+// below this many elements threads cost more than they save
+constexpr long kParallelElements = 1L << 16;
+constexpr long kChunkElements = 1L << 14;
+// narrower column chunks would read only a part of every cache line
+constexpr int kMinColumnChunk = 64;
+
+// runs body over [0, count) on the library pool when the work is large enough
+void ForEachChunk(int count, long elements_per_index,
+                  const std::function<void(int, int)>& body) {
+  if (count * elements_per_index < kParallelElements) {
+    body(0, count);
+    return;
+  }
 
-S21Matrix::S21Matrix() : S21Matrix(5, 5){};
+  int grain = std::max(1L, kChunkElements / elements_per_index);
+  S21ThreadPool::Instance().ParallelFor(0, count, grain, body);
+}
+
+// Four doubles, one AVX register or two SSE2 ones. GCC and Clang lower the
+// arithmetic to whatever vector unit the target has.
+typedef double Double4 __attribute__((vector_size(4 * sizeof(double))));
+
+// Knuth's TwoSum: adds the exact rounding error of sum + value to the
+// compensation without a branch, for doubles and lane by lane for Double4
+template <typename T>
+inline void CompensatedAdd(T& sum, T& compensation, const T& value) {
+  T total = sum + value;
+  T value_part = total - sum;
+  compensation += (sum - (total - value_part)) + (value - value_part);
+  sum = total;
+}
+
+// Once the sum overflowed or met an infinity the compensation is inf - inf,
+// the sum alone is the result then
+inline double CompensatedResult(double sum, double compensation) {
+  return std::isfinite(sum) ? sum + compensation : sum;
+}
+
+// Compensated sum (Ogita, Rump and Oishi's Sum2): as accurate as summing in
+// twice the precision and rounding, the error is at most about
+// eps * |sum| + (n * eps)^2 * sum |values|
+struct CompensatedSum {
+  double sum = 0;
+  double compensation = 0;
+
+  void Add(double value) { CompensatedAdd(sum, compensation, value); }
+  double Result() const { return CompensatedResult(sum, compensation); }
+};
+
+// eight independent lanes in two vectors, the values left over go to a
+// scalar lane
+struct CompensatedLanes {
+  static constexpr int kVectors = 2;
+  static constexpr int kWidth = 4;
+  Double4 sums[kVectors] = {};
+  Double4 compensations[kVectors] = {};
+  CompensatedSum rest;
+
+  template <typename Transform>
+  void Add(const double* values, int count, Transform transform) {
+    int i = 0;
+    for (; i + kVectors * kWidth <= count; i += kVectors * kWidth) {
+      for (int v = 0; v < kVectors; v++) {
+        const double* x = values + i + v * kWidth;
+        Double4 lanes = {transform(x[0]), transform(x[1]), transform(x[2]),
+                         transform(x[3])};
+        CompensatedAdd(sums[v], compensations[v], lanes);
+      }
+    }
+    for (; i < count; i++) {
+      rest.Add(transform(values[i]));
+    }
+  }
+
+  double Result() const {
+    CompensatedSum total;
+    for (int v = 0; v < kVectors; v++) {
+      for (int lane = 0; lane < kWidth; lane++) {
+        total.Add(sums[v][lane]);
+      }
+    }
+    total.Add(rest.sum);
+    for (int v = 0; v < kVectors; v++) {
+      for (int lane = 0; lane < kWidth; lane++) {
+        total.Add(std::isfinite(sums[v][lane]) ? compensations[v][lane] : 0);
+      }
+    }
+    total.Add(std::isfinite(rest.sum) ? rest.compensation : 0);
+    return total.Result();
+  }
+};
+
+// Sum of transform over all values. Every block of rows is summed by one
+// thread and the block results are added in order, the block size depends
+// on the shape only.
+template <typename Transform>
+double SumRows(double* const* rows, int rows_count, int cols,
+               Transform transform) {
+  int block_rows = std::max(1L, kChunkElements / cols);
+  int blocks = (rows_count + block_rows - 1) / block_rows;
+  std::vector<double> partials(blocks);
+  ForEachChunk(blocks, static_cast<long>(block_rows) * cols,
+               [&](int from, int to) {
+                 for (int block = from; block < to; block++) {
+                   CompensatedLanes sum;
+                   int last = std::min(rows_count, (block + 1) * block_rows);
+                   for (int i = block * block_rows; i < last; i++) {
+                     sum.Add(rows[i], cols, transform);
+                   }
+                   partials[block] = sum.Result();
+                 }
+               });
+
+  CompensatedLanes total;
+  total.Add(partials.data(), blocks, [](double value) { return value; });
+  return total.Result();
+}
+
+// splitmix64: the n-th output of the stream of a seed, computed directly
+std::uint64_t RandomBits(std::uint64_t seed, std::uint64_t counter) {
+  std::uint64_t z = seed + (counter + 1) * 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+// [0, 1) with all 53 bits of precision
+double UniformDouble(std::uint64_t bits) {
+  return static_cast<double>(bits >> 11) * 0x1.0p-53;
+}
+
+void CheckDimensions(int rows, int cols) {
   if (rows <= 0 || cols <= 0) {
     throw std::invalid_argument(
         "CreationError: The number of rows or cols cannot be less than 1");
   }
+}
+
+// std::max and std::max_element drop a NaN that is not the first value, here
+// a NaN wins over everything that follows it
+double MaxOf(const double* values, int count) {
+  double max = values[0];
+  for (int i = 1; i < count; i++) {
+    if (values[i] > max || std::isnan(values[i])) {
+      max = values[i];
+    }
+  }
+  return max;
+}
+
+constexpr auto kIdentity = [](double value) { return value; };
+constexpr auto kAbsolute = [](double value) { return std::fabs(value); };
+}  // namespace
+
+// CONSTRUCTORS
+
+S21Matrix::S21Matrix() : S21Matrix(5, 5){};
+
+S21Matrix::S21Matrix(int rows, int cols)
+    : rows_(rows),
+      cols_(cols),
+      matrix_(nullptr),
+      header_(nullptr),
+      cow_(false) {
+  CheckDimensions(rows, cols);
   AllocateMemory();
 }
 
+S21Matrix::S21Matrix(int rows, int cols, double* values)
+    : rows_(rows),
+      cols_(cols),
+      matrix_(nullptr),
+      header_(nullptr),
+      cow_(false) {
+  CheckDimensions(rows, cols);
+  if (values) {
+    AdoptMemory(values);
+  } else {
+    AllocateMemory(false);
+  }
+}
+
 S21Matrix::S21Matrix(const S21Matrix& other)
-    : rows_(other.rows_), cols_(other.cols_) {
-  AllocateMemory();
-  CopyValues(other);
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(nullptr),
+      header_(nullptr),
+      cow_(other.cow_) {
+  if (other.CanShare()) {
+    ShareMemory(other);
+  } else {
+    AllocateMemory(false);
+    CopyValues(other);
+  }
 }
 
 S21Matrix::S21Matrix(S21Matrix&& other) noexcept
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(other.matrix_),
+      header_(other.header_),
+      cow_(other.cow_) {
   other.rows_ = 0;
   other.cols_ = 0;
   other.matrix_ = nullptr;
+  other.header_ = nullptr;
+}
+
+S21Matrix::Distribution::Distribution(Kind kind, double first, double second)
+    : kind_(kind), first_(first), second_(second) {}
+
+S21Matrix::Distribution S21Matrix::Distribution::Uniform(double low,
+                                                         double high) {
+  return Distribution(Kind::kUniform, low, high);
+}
+
+S21Matrix::Distribution S21Matrix::Distribution::Normal(double mean,
+                                                        double deviation) {
+  return Distribution(Kind::kNormal, mean, deviation);
+}
+
+// FACTORIES
+
+S21Matrix S21Matrix::Identity(int size) {
+  CheckDimensions(size, size);
+  S21TraceScope trace(S21TraceOp::kIdentity, size, size);
+  S21Matrix identity = Uninitialized(size, size);
+  identity.SetIdentity();
+  return identity;
+}
+
+S21Matrix S21Matrix::Filled(int rows, int cols, double value) {
+  CheckDimensions(rows, cols);
+  S21TraceScope trace(S21TraceOp::kFilled, rows, cols);
+  S21Matrix filled = Uninitialized(rows, cols);
+  ForEachChunk(rows, cols, [&](int from, int to) {
+    std::fill(filled.matrix_[from],
+              filled.matrix_[from] + static_cast<std::size_t>(to - from) * cols,
+              value);
+  });
+  return filled;
+}
+
+S21Matrix S21Matrix::Uninitialized(int rows, int cols) {
+  return S21Matrix(rows, cols, nullptr);
+}
+
+S21Matrix S21Matrix::FromBuffer(const double* data, int rows, int cols,
+                                int stride) {
+  CheckDimensions(rows, cols);
+  if (stride < cols || !data) {
+    throw std::invalid_argument(
+        "CreationError: The stride cannot be less than the number of cols "
+        "and the data cannot be null");
+  }
+
+  S21TraceScope trace(S21TraceOp::kFromBuffer, rows, cols, 0, 0, stride);
+  S21Matrix matrix = Uninitialized(rows, cols);
+  ForEachChunk(rows, cols, [&](int from, int to) {
+    for (int i = from; i < to; i++) {
+      const double* row = data + static_cast<std::size_t>(i) * stride;
+      std::memcpy(matrix.matrix_[i], row, cols * sizeof(double));
+    }
+  });
+  return matrix;
+}
+
+S21Matrix S21Matrix::FromBuffer(std::unique_ptr<double[]> data, int rows,
+                                int cols) {
+  CheckDimensions(rows, cols);
+  if (!data) {
+    throw std::invalid_argument("CreationError: The data cannot be null");
+  }
+
+  S21Matrix matrix(rows, cols, data.get());
+  data.release();
+  return matrix;
+}
+
+S21Matrix S21Matrix::Random(int rows, int cols,
+                            const Distribution& distribution,
+                            std::uint64_t seed) {
+  CheckDimensions(rows, cols);
+  S21TraceScope trace(S21TraceOp::kRandom, rows, cols);
+  S21Matrix random = Uninitialized(rows, cols);
+  ForEachChunk(rows, cols, [&](int from, int to) {
+    for (int i = from; i < to; i++) {
+      double* row = random.matrix_[i];
+      std::uint64_t counter = static_cast<std::uint64_t>(i) * cols;
+      if (distribution.kind_ == Distribution::Kind::kUniform) {
+        double width = distribution.second_ - distribution.first_;
+        for (int j = 0; j < cols; j++) {
+          row[j] = distribution.first_ +
+                   width * UniformDouble(RandomBits(seed, counter + j));
+        }
+      } else {
+        // Box-Muller on two draws of the same stream
+        for (int j = 0; j < cols; j++) {
+          std::uint64_t index = 2 * (counter + j);
+          double radius = std::sqrt(
+              -2 * std::log(1 - UniformDouble(RandomBits(seed, index))));
+          double angle = 2 * M_PI * UniformDouble(RandomBits(seed, index + 1));
+          row[j] = distribution.first_ +
+                   distribution.second_ * radius * std::cos(angle);
+        }
+      }
+    }
+  });
+  return random;
 }
 
 // ASSIGNMENT OPERATORS
 
 S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
-  if (this != &other) {
+  if (this != &other && (!other.CanShare() || header_ != other.header_)) {
     FreeMemory();
     rows_ = other.rows_;
     cols_ = other.cols_;
-    AllocateMemory();
-    CopyValues(other);
+    if (other.CanShare()) {
+      ShareMemory(other);
+    } else {
+      AllocateMemory(false);
+      CopyValues(other);
+    }
   }
+  cow_ = other.cow_;
 
   return *this;
 }
@@ -46,10 +347,13 @@ S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
     rows_ = other.rows_;
     cols_ = other.cols_;
     matrix_ = other.matrix_;
+    header_ = other.header_;
+    cow_ = other.cow_;
 
     other.rows_ = 0;
     other.cols_ = 0;
     other.matrix_ = nullptr;
+    other.header_ = nullptr;
   }
 
   return *this;
@@ -92,6 +396,7 @@ void S21Matrix::SetRows(int rows) {
   }
 
   S21Matrix tmp(rows, cols_);
+  tmp.cow_ = cow_;
   int rows_range = rows < rows_ ? rows : rows_;
   for (int i = 0; i < rows_range; i++) {
     for (int j = 0; j < cols_; j++) {
@@ -99,7 +404,7 @@ void S21Matrix::SetRows(int rows) {
     }
   }
 
-  *this = tmp;
+  *this = std::move(tmp);
 }
 
 void S21Matrix::SetCols(int cols) {
@@ -109,6 +414,7 @@ void S21Matrix::SetCols(int cols) {
   }
 
   S21Matrix tmp(rows_, cols);
+  tmp.cow_ = cow_;
   int cols_range = cols < cols_ ? cols : cols_;
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_range; j++) {
@@ -116,24 +422,53 @@ void S21Matrix::SetCols(int cols) {
     }
   }
 
-  *this = tmp;
+  *this = std::move(tmp);
+}
+
+// COPY-ON-WRITE
+
+void S21Matrix::SetCopyOnWrite(bool enabled) {
+  if (!enabled) {
+    Detach();
+  }
+  cow_ = enabled;
+}
+
+bool S21Matrix::IsCopyOnWrite() const { return cow_; }
+
+bool S21Matrix::IsShared() const {
+  return header_ && header_->refs.load(std::memory_order_acquire) > 1;
+}
+
+void S21Matrix::Detach() {
+  if (!IsShared()) {
+    return;
+  }
+
+  double** shared_matrix = matrix_;
+  SharedHeader* shared_header = header_;
+  AllocateMemory(false);
+  for (int i = 0; i < rows_; i++) {
+    std::memcpy(matrix_[i], shared_matrix[i], cols_ * sizeof(double));
+  }
+  ReleaseMemory(shared_header);
 }
 
 // OVERLOAD OPERATORS
 
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
+S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
   S21Matrix res_matrix(*this);
   res_matrix.SumMatrix(other);
   return res_matrix;
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
+S21Matrix S21Matrix::operator-(const S21Matrix& other) const {
   S21Matrix res_matrix(*this);
   res_matrix.SubMatrix(other);
   return res_matrix;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
+S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
   S21Matrix res_matrix(*this);
   res_matrix.MulMatrix(other);
   return res_matrix;
@@ -145,19 +480,28 @@ S21Matrix S21Matrix::operator*(double num) const {
   return res_matrix;
 }
 
-S21Matrix operator*(double num, S21Matrix& matrix) { return matrix * num; }
+S21Matrix operator*(double num, const S21Matrix& matrix) { return matrix * num; }
+
+S21Vector S21Matrix::operator*(const S21Vector& x) const {
+  S21Vector y(rows_);
+  Gemv(1, x, 0, y);
+  return y;
+}
 
-bool S21Matrix::operator==(const S21Matrix& other) { return EqMatrix(other); }
+bool S21Matrix::operator==(const S21Matrix& other) const {
+  return EqMatrix(other);
+}
 
 double& S21Matrix::operator()(int row, int col) {
   if (row < 0 || col < 0 || row >= rows_ || col >= cols_) {
     throw std::out_of_range("InvalidIndexError: Index is out of range");
   }
 
+  PrepareReference();
   return matrix_[row][col];
 }
 
-double& S21Matrix::operator()(int row, int col) const {
+const double& S21Matrix::operator()(int row, int col) const {
   if (row < 0 || col < 0 || row >= rows_ || col >= cols_) {
     throw std::out_of_range("InvalidIndexError: Index is out of range");
   }
@@ -167,17 +511,32 @@ double& S21Matrix::operator()(int row, int col) const {
 
 // MEMBER FUNCTIONS
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) {
-  return std::memcmp(matrix_ + rows_, other.matrix_ + rows_, rows_ * cols_) ==
-             0 &&
-         IsMatrixSameDimension(other);
+bool S21Matrix::EqMatrix(const S21Matrix& other) const {
+  if (!IsMatrixSameDimension(other)) {
+    return false;
+  }
+
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      double a = matrix_[i][j], b = other.matrix_[i][j];
+      // written so that a NaN is never equal, equal infinities are
+      if (a != b && !(std::fabs(a - b) <= kEqPrecision)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
 }
 
 void S21Matrix::SumMatrix(const S21Matrix& other) {
+  S21TraceScope trace(S21TraceOp::kSumMatrix, rows_, cols_, other.rows_,
+                      other.cols_);
   if (!IsMatrixSameDimension(other)) {
     throw std::range_error("SumMatrixError: Matrices of different dimensions");
   }
 
+  PrepareWrite();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] += other.matrix_[i][j];
@@ -186,10 +545,13 @@ void S21Matrix::SumMatrix(const S21Matrix& other) {
 }
 
 void S21Matrix::SubMatrix(const S21Matrix& other) {
+  S21TraceScope trace(S21TraceOp::kSubMatrix, rows_, cols_, other.rows_,
+                      other.cols_);
   if (!IsMatrixSameDimension(other)) {
     throw std::range_error("SubMatrixError: Matrices of different dimensions");
   }
 
+  PrepareWrite();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] -= other.matrix_[i][j];
@@ -198,6 +560,8 @@ void S21Matrix::SubMatrix(const S21Matrix& other) {
 }
 
 void S21Matrix::MulNumber(const double num) {
+  S21TraceScope trace(S21TraceOp::kMulNumber, rows_, cols_);
+  PrepareWrite();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] *= num;
@@ -206,26 +570,22 @@ void S21Matrix::MulNumber(const double num) {
 }
 
 void S21Matrix::MulMatrix(const S21Matrix& other) {
+  S21TraceScope trace(S21TraceOp::kMulMatrix, rows_, cols_, other.rows_,
+                      other.cols_);
   if (cols_ != other.rows_) {
     throw std::range_error(
         "MulMatrixError: Incorrect dimensions to multiply two matrices");
   }
 
   S21Matrix res_matrix(rows_, other.cols_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      double sum = 0;
-      for (int k = 0; k < cols_; k++) {
-        sum += matrix_[i][k] * other.matrix_[k][j];
-      }
-      res_matrix.matrix_[i][j] = sum;
-    }
-  }
+  MulInto(*this, other, res_matrix);
 
-  *this = res_matrix;
+  res_matrix.cow_ = cow_;
+  *this = std::move(res_matrix);
 }
 
-S21Matrix S21Matrix::Transpose() {
+S21Matrix S21Matrix::Transpose() const {
+  S21TraceScope trace(S21TraceOp::kTranspose, rows_, cols_);
   S21Matrix transposed_matrix(cols_, rows_);
 
   for (int i = 0; i < rows_; i++) {
@@ -237,7 +597,8 @@ S21Matrix S21Matrix::Transpose() {
   return transposed_matrix;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
+S21Matrix S21Matrix::CalcComplements() const {
+  S21TraceScope trace(S21TraceOp::kCalcComplements, rows_, cols_);
   if (!IsMatrixSquare()) {
     throw std::range_error("CalcComplementsError: The matrix must be square");
   }
@@ -259,7 +620,8 @@ S21Matrix S21Matrix::CalcComplements() {
   return res_matrix;
 }
 
-double S21Matrix::Determinant() {
+double S21Matrix::Determinant() const {
+  S21TraceScope trace(S21TraceOp::kDeterminant, rows_, cols_);
   if (!IsMatrixSquare()) {
     throw std::range_error("DeterminantError: The matrix must be square");
   }
@@ -281,9 +643,10 @@ double S21Matrix::Determinant() {
   return det;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
+S21Matrix S21Matrix::InverseMatrix() const {
+  S21TraceScope trace(S21TraceOp::kInverseMatrix, rows_, cols_);
   double det = Determinant();
-  if (!Determinant() || !IsMatrixSquare()) {
+  if (!det || !IsMatrixSquare()) {
     throw std::range_error(
         "InverseError: Incompatible matrix sizes to search inverse matrix");
   }
@@ -299,24 +662,374 @@ S21Matrix S21Matrix::InverseMatrix() {
   return res_matrix;
 }
 
+S21Matrix S21Matrix::Solve(const S21Matrix& b) const {
+  S21TraceScope trace(S21TraceOp::kSolve, rows_, cols_, b.rows_, b.cols_);
+  if (!IsMatrixSquare() || b.rows_ != rows_) {
+    throw std::range_error(
+        "SolveError: Incompatible matrix sizes to solve the system");
+  }
+
+  S21Matrix lu(rows_, cols_);
+  std::vector<int> pivots;
+  if (!Factorize(lu, pivots)) {
+    throw std::range_error("SolveError: The matrix is singular");
+  }
+
+  return SolveFactorized(lu, pivots, b);
+}
+
+S21Matrix S21Matrix::Pow(int k) const {
+  S21TraceScope trace(S21TraceOp::kPow, rows_, cols_, 0, 0, k);
+  if (!IsMatrixSquare()) {
+    throw std::range_error("PowError: The matrix must be square");
+  }
+
+  // three buffers are allocated once and swapped, squaring does not allocate
+  S21Matrix res_matrix(rows_, cols_);
+  S21Matrix tmp(rows_, cols_);
+  res_matrix.SetIdentity();
+  S21Matrix base = k < 0 ? Solve(res_matrix) : S21Matrix(*this);
+  base.SetCopyOnWrite(false);
+  // unsigned to handle k == INT_MIN
+  unsigned int power = k < 0 ? 0u - static_cast<unsigned int>(k) : k;
+  bool is_identity = true;
+  while (power) {
+    if (power & 1u) {
+      if (is_identity) {
+        res_matrix.CopyValues(base);
+        is_identity = false;
+      } else {
+        MulInto(res_matrix, base, tmp);
+        std::swap(res_matrix, tmp);
+      }
+    }
+    power >>= 1;
+    if (power) {
+      MulInto(base, base, tmp);
+      std::swap(base, tmp);
+    }
+  }
+
+  return res_matrix;
+}
+
+S21Matrix S21Matrix::Exp() const {
+  S21TraceScope trace(S21TraceOp::kExp, rows_, cols_);
+  if (!IsMatrixSquare()) {
+    throw std::range_error("ExpError: The matrix must be square");
+  }
+
+  double norm = 0;
+  for (int i = 0; i < rows_; i++) {
+    double row_sum = 0;
+    for (int j = 0; j < cols_; j++) {
+      row_sum += std::fabs(matrix_[i][j]);
+    }
+    // fmax would drop a NaN, and the squarings below must fit an int
+    if (!std::isfinite(row_sum)) {
+      throw std::range_error("ExpError: The matrix must be finite");
+    }
+    norm = std::fmax(norm, row_sum);
+  }
+  // scaling so that the norm of A / 2^squarings is at most 1/2
+  int squarings = 0;
+  if (norm > 0.5) {
+    squarings = static_cast<int>(std::ceil(std::log2(norm / 0.5)));
+  }
+
+  // diagonal Pade approximant of degree 6, Golub & Van Loan, Algorithm 11.3.1
+  const int degree = 6;
+  S21Matrix scaled = *this * std::ldexp(1.0, -squarings);
+  S21Matrix power(scaled);
+  power.SetCopyOnWrite(false);
+  S21Matrix numerator(rows_, cols_);
+  S21Matrix denominator(rows_, cols_);
+  S21Matrix tmp(rows_, cols_);
+  numerator.SetIdentity();
+  denominator.SetIdentity();
+  double c = 1;
+  for (int k = 1; k <= degree; k++) {
+    c *= static_cast<double>(degree - k + 1) / (k * (2 * degree - k + 1));
+    if (k > 1) {
+      MulInto(scaled, power, tmp);
+      std::swap(power, tmp);
+    }
+    double sign = k % 2 == 0 ? 1 : -1;
+    for (int i = 0; i < rows_; i++) {
+      for (int j = 0; j < cols_; j++) {
+        numerator.matrix_[i][j] += c * power.matrix_[i][j];
+        denominator.matrix_[i][j] += sign * c * power.matrix_[i][j];
+      }
+    }
+  }
+
+  S21Matrix res_matrix = denominator.Solve(numerator);
+  for (int i = 0; i < squarings; i++) {
+    MulInto(res_matrix, res_matrix, tmp);
+    std::swap(res_matrix, tmp);
+  }
+
+  return res_matrix;
+}
+
+void S21Matrix::Gemv(double alpha, const S21Vector& x, double beta,
+                     S21Vector& y) const {
+  S21TraceScope trace(S21TraceOp::kGemv, rows_, cols_);
+  if (x.size_ != cols_ || y.size_ != rows_) {
+    throw std::range_error("GemvError: Incorrect dimensions of the vectors");
+  }
+  if (&x == &y) {
+    S21Vector x_copy(x);
+    Gemv(alpha, x_copy, beta, y);
+    return;
+  }
+
+  const double* x_data = x.data_;
+  double* y_data = y.data_;
+  ForEachChunk(rows_, cols_, [&](int from, int to) {
+    for (int i = from; i < to; i++) {
+      const double* row = matrix_[i];
+      // independent partial sums let the compiler vectorize the reduction
+      double sum[4] = {0, 0, 0, 0};
+      int j = 0;
+      for (; j + 4 <= cols_; j += 4) {
+        for (int lane = 0; lane < 4; lane++) {
+          sum[lane] += row[j + lane] * x_data[j + lane];
+        }
+      }
+      for (; j < cols_; j++) {
+        sum[0] += row[j] * x_data[j];
+      }
+      double dot = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+      // beta == 0 ignores y completely, as in BLAS
+      y_data[i] = beta == 0 ? alpha * dot : alpha * dot + beta * y_data[i];
+    }
+  });
+}
+
+void S21Matrix::Gevm(double alpha, const S21Vector& x, double beta,
+                     S21Vector& y) const {
+  S21TraceScope trace(S21TraceOp::kGevm, rows_, cols_);
+  if (x.size_ != rows_ || y.size_ != cols_) {
+    throw std::range_error("GevmError: Incorrect dimensions of the vectors");
+  }
+  if (&x == &y) {
+    S21Vector x_copy(x);
+    Gevm(alpha, x_copy, beta, y);
+    return;
+  }
+
+  const double* x_data = x.data_;
+  double* y_data = y.data_;
+  auto body = [&](int from, int to) {
+    for (int j = from; j < to; j++) {
+      y_data[j] = beta == 0 ? 0 : beta * y_data[j];
+    }
+    for (int i = 0; i < rows_; i++) {
+      const double* row = matrix_[i];
+      double factor = alpha * x_data[i];
+      for (int j = from; j < to; j++) {
+        y_data[j] += factor * row[j];
+      }
+    }
+  };
+
+  if (static_cast<long>(rows_) * cols_ < kParallelElements) {
+    body(0, cols_);
+    return;
+  }
+  // every chunk walks all rows, tall matrices still get whole cache lines
+  int grain = std::max<long>(kMinColumnChunk, kChunkElements / rows_);
+  S21ThreadPool::Instance().ParallelFor(0, cols_, grain, body);
+}
+
+double S21Matrix::Trace() const {
+  S21TraceScope trace(S21TraceOp::kTrace, rows_, cols_);
+  if (!IsMatrixSquare()) {
+    throw std::range_error("TraceError: The matrix must be square");
+  }
+
+  CompensatedSum sum;
+  for (int i = 0; i < rows_; i++) {
+    sum.Add(matrix_[i][i]);
+  }
+
+  return sum.Result();
+}
+
+double S21Matrix::Sum() const {
+  S21TraceScope trace(S21TraceOp::kSum, rows_, cols_);
+  return SumRows(matrix_, rows_, cols_, kIdentity);
+}
+
+double S21Matrix::NormFrobenius() const {
+  S21TraceScope trace(S21TraceOp::kNormFrobenius, rows_, cols_);
+  auto square = [](double value) { return value * value; };
+  double squares = SumRows(matrix_, rows_, cols_, square);
+  // below this the small squares lose digits as subnormal numbers
+  double min_squares = std::numeric_limits<double>::min() /
+                       std::numeric_limits<double>::epsilon();
+  if (std::isfinite(squares) && squares >= min_squares) {
+    return std::sqrt(squares);
+  }
+
+  // the squares left the range of double, the scaled ones stay near 1
+  double max = MaxAbs();
+  if (max == 0 || !std::isfinite(max)) {
+    return max;
+  }
+  squares = SumRows(matrix_, rows_, cols_, [max](double value) {
+    double scaled = value / max;
+    return scaled * scaled;
+  });
+  return max * std::sqrt(squares);
+}
+
+double S21Matrix::Norm1() const {
+  S21TraceScope trace(S21TraceOp::kNorm1, rows_, cols_);
+  S21Vector sums(cols_);
+  SumColsInto(kAbsolute, sums);
+  return MaxOf(sums.data_, cols_);
+}
+
+double S21Matrix::NormInf() const {
+  S21TraceScope trace(S21TraceOp::kNormInf, rows_, cols_);
+  S21Vector sums(rows_);
+  SumRowsInto(kAbsolute, sums);
+  return MaxOf(sums.data_, rows_);
+}
+
+double S21Matrix::MaxAbs() const {
+  S21TraceScope trace(S21TraceOp::kMaxAbs, rows_, cols_);
+  std::vector<double> maxima(rows_);
+  ForEachChunk(rows_, cols_, [&](int from, int to) {
+    for (int i = from; i < to; i++) {
+      const double* row = matrix_[i];
+      double max = 0;
+      for (int j = 0; j < cols_; j++) {
+        double value = std::fabs(row[j]);
+        if (value > max || std::isnan(value)) {
+          max = value;
+        }
+      }
+      maxima[i] = max;
+    }
+  });
+
+  return MaxOf(maxima.data(), rows_);
+}
+
+S21Vector S21Matrix::RowSums() const {
+  S21TraceScope trace(S21TraceOp::kRowSums, rows_, cols_);
+  S21Vector sums(rows_);
+  SumRowsInto(kIdentity, sums);
+  return sums;
+}
+
+S21Vector S21Matrix::ColSums() const {
+  S21TraceScope trace(S21TraceOp::kColSums, rows_, cols_);
+  S21Vector sums(cols_);
+  SumColsInto(kIdentity, sums);
+  return sums;
+}
+
 // PRIVATE MEMBER FUNCTIONS
 
-void S21Matrix::AllocateMemory() {
-  // allocating one block of memory for everything at once
-  matrix_ = new double*[rows_ + rows_ * cols_]();
-  // pointer to start values ​​after pointers
+template <typename Transform>
+void S21Matrix::SumRowsInto(Transform transform, S21Vector& sums) const {
+  ForEachChunk(rows_, cols_, [&](int from, int to) {
+    for (int i = from; i < to; i++) {
+      CompensatedLanes sum;
+      sum.Add(matrix_[i], cols_, transform);
+      sums.data_[i] = sum.Result();
+    }
+  });
+}
+
+template <typename Transform>
+void S21Matrix::SumColsInto(Transform transform, S21Vector& sums) const {
+  // every column is summed top to bottom by one thread
+  auto body = [&](int from, int to) {
+    int count = to - from;
+    std::vector<double> column_sums(count), compensations(count);
+    double* column_sum = column_sums.data();
+    double* compensation = compensations.data();
+    for (int i = 0; i < rows_; i++) {
+      const double* row = matrix_[i] + from;
+      for (int j = 0; j < count; j++) {
+        CompensatedAdd(column_sum[j], compensation[j], transform(row[j]));
+      }
+    }
+    for (int j = 0; j < count; j++) {
+      sums.data_[from + j] =
+          CompensatedResult(column_sum[j], compensation[j]);
+    }
+  };
+
+  if (static_cast<long>(rows_) * cols_ < kParallelElements) {
+    body(0, cols_);
+    return;
+  }
+  S21ThreadPool::Instance().ParallelFor(0, cols_, kMinColumnChunk, body);
+}
+
+void S21Matrix::AllocateMemory(bool zeroed) {
+  // allocating one block of memory for everything at once:
+  // shared header, row pointers and values
+  std::size_t values_count = static_cast<std::size_t>(rows_) * cols_;
+  char* block = static_cast<char*>(
+      ::operator new(sizeof(SharedHeader) + rows_ * sizeof(double*) +
+                     values_count * sizeof(double)));
+  matrix_ = reinterpret_cast<double**>(block + sizeof(SharedHeader));
+  // pointer to start values after pointers
   double* start = (double*)(matrix_ + rows_);
+  header_ = new (block) SharedHeader{{1}, start, false, false};
   // indexing our matrix
-  int iteration_limit = rows_ <= cols_ ? cols_ : rows_;
-  for (int i = 0; i < iteration_limit; i++) {
+  for (int i = 0; i < rows_; i++) {
     matrix_[i] = start + i * cols_;
   }
-  std::memset(start, 0, rows_ * cols_);
+  if (zeroed) {
+    std::memset(start, 0, values_count * sizeof(double));
+  }
+}
+
+void S21Matrix::AdoptMemory(double* values) {
+  // the block holds only the header and the row pointers
+  char* block = static_cast<char*>(
+      ::operator new(sizeof(SharedHeader) + rows_ * sizeof(double*)));
+  header_ = new (block) SharedHeader{{1}, values, true, false};
+  matrix_ = reinterpret_cast<double**>(block + sizeof(SharedHeader));
+  for (int i = 0; i < rows_; i++) {
+    matrix_[i] = values + static_cast<std::size_t>(i) * cols_;
+  }
 }
 
 void S21Matrix::FreeMemory() {
-  if (matrix_) {
-    delete[] matrix_;
+  ReleaseMemory(header_);
+  header_ = nullptr;
+  matrix_ = nullptr;
+}
+
+void S21Matrix::ReleaseMemory(SharedHeader* header) {
+  // the last owner releases the block
+  if (header && header->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    if (header->adopted) {
+      delete[] header->values;
+    }
+    header->~SharedHeader();
+    ::operator delete(header);
+  }
+}
+
+bool S21Matrix::CanShare() const {
+  return cow_ && !(header_ && header_->unshareable);
+}
+
+void S21Matrix::ShareMemory(const S21Matrix& other) {
+  header_ = other.header_;
+  matrix_ = other.matrix_;
+  if (header_) {
+    header_->refs.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -328,7 +1041,7 @@ void S21Matrix::CopyValues(const S21Matrix& other) {
   }
 }
 
-S21Matrix S21Matrix::Minor(int ex_row, int ex_col) {
+S21Matrix S21Matrix::Minor(int ex_row, int ex_col) const {
   S21Matrix minor(rows_ - 1, cols_ - 1);
 
   for (int i = 0, minor_row = 0; i < rows_; i++) {
@@ -346,10 +1059,107 @@ S21Matrix S21Matrix::Minor(int ex_row, int ex_col) {
   return minor;
 }
 
-bool S21Matrix::IsMatrixSameDimension(S21Matrix matrix) {
+void S21Matrix::MulInto(const S21Matrix& a, const S21Matrix& b,
+                        S21Matrix& res) {
+  double** a_rows = a.matrix_;
+  double** b_rows = b.matrix_;
+  double** res_rows = res.matrix_;
+  Gemm(
+      a.rows_, a.cols_, b.cols_, [a_rows](int i) { return a_rows[i]; },
+      [b_rows](int k) { return b_rows[k]; },
+      [res_rows](int i) { return res_rows[i]; }, S21GemmUpdate::kAssign);
+}
+
+S21Matrix S21Matrix::SolveFactorized(const S21Matrix& lu,
+                                     const std::vector<int>& pivots,
+                                     const S21Matrix& b) {
+  S21Matrix res_matrix(lu.rows_, b.cols_);
+  for (int i = 0; i < lu.rows_; i++) {
+    std::memcpy(res_matrix.matrix_[i], b.matrix_[pivots[i]],
+                b.cols_ * sizeof(double));
+  }
+  // forward substitution with the unit lower triangle
+  for (int i = 0; i < lu.rows_; i++) {
+    double* x_row = res_matrix.matrix_[i];
+    for (int k = 0; k < i; k++) {
+      double l_ik = lu.matrix_[i][k];
+      const double* x_k = res_matrix.matrix_[k];
+      for (int j = 0; j < b.cols_; j++) {
+        x_row[j] -= l_ik * x_k[j];
+      }
+    }
+  }
+  // back substitution with the upper triangle
+  for (int i = lu.rows_ - 1; i >= 0; i--) {
+    double* x_row = res_matrix.matrix_[i];
+    for (int k = i + 1; k < lu.rows_; k++) {
+      double u_ik = lu.matrix_[i][k];
+      const double* x_k = res_matrix.matrix_[k];
+      for (int j = 0; j < b.cols_; j++) {
+        x_row[j] -= u_ik * x_k[j];
+      }
+    }
+    double u_ii = lu.matrix_[i][i];
+    for (int j = 0; j < b.cols_; j++) {
+      x_row[j] /= u_ii;
+    }
+  }
+
+  return res_matrix;
+}
+
+int S21Matrix::Factorize(S21Matrix& lu, std::vector<int>& pivots) const {
+  lu.CopyValues(*this);
+  pivots.resize(rows_);
+  for (int i = 0; i < rows_; i++) {
+    pivots[i] = i;
+  }
+
+  int sign = 1;
+  for (int k = 0; k < rows_; k++) {
+    int pivot_row = k;
+    for (int i = k + 1; i < rows_; i++) {
+      if (std::fabs(lu.matrix_[i][k]) > std::fabs(lu.matrix_[pivot_row][k])) {
+        pivot_row = i;
+      }
+    }
+    if (lu.matrix_[pivot_row][k] == 0) {
+      return 0;
+    }
+    if (pivot_row != k) {
+      // rows are swapped through the row pointer table
+      std::swap(lu.matrix_[k], lu.matrix_[pivot_row]);
+      std::swap(pivots[k], pivots[pivot_row]);
+      sign = -sign;
+    }
+
+    const double* pivot = lu.matrix_[k];
+    for (int i = k + 1; i < rows_; i++) {
+      double* row = lu.matrix_[i];
+      double factor = row[k] / pivot[k];
+      row[k] = factor;
+      for (int j = k + 1; j < cols_; j++) {
+        row[j] -= factor * pivot[j];
+      }
+    }
+  }
+
+  return sign;
+}
+
+void S21Matrix::SetIdentity() {
+  ForEachChunk(rows_, cols_, [this](int from, int to) {
+    for (int i = from; i < to; i++) {
+      std::memset(matrix_[i], 0, cols_ * sizeof(double));
+      matrix_[i][i] = 1;
+    }
+  });
+}
+
+bool S21Matrix::IsMatrixSameDimension(const S21Matrix& matrix) const {
   return (rows_ == matrix.rows_ && cols_ == matrix.cols_);
 }
 
-bool S21Matrix::IsMatrixSquare() { return (cols_ == rows_); }
+bool S21Matrix::IsMatrixSquare() const { return (cols_ == rows_); }
 
 }  // namespace s_21
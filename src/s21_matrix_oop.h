@@ -3,13 +3,45 @@
 #ifndef CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_OOP_H_
 #define CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_OOP_H_
 
+#include <atomic>
+#include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_span.h"
 
 namespace s_21 {
+class S21Vector;
+
 class S21Matrix {
  public:
+  static constexpr double kEqPrecision = 1e-7;
+
+  // Values of Random
+  class Distribution {
+   public:
+    // [low, high)
+    static Distribution Uniform(double low = 0, double high = 1);
+    static Distribution Normal(double mean = 0, double deviation = 1);
+
+   private:
+    friend class S21Matrix;
+    enum class Kind { kUniform, kNormal };
+
+    Kind kind_;
+    double first_, second_;
+
+    Distribution(Kind kind, double first, double second);
+  };
+
   // Constructors
 
   S21Matrix();
@@ -20,6 +52,45 @@ class S21Matrix {
   S21Matrix(const S21Matrix& other);
   S21Matrix(S21Matrix&& other) noexcept;
 
+  // Factories
+
+  /**
+   * @throws CreationError: The number of rows or cols cannot be less than 1
+   */
+  static S21Matrix Identity(int size);
+  /**
+   * @throws CreationError: The number of rows or cols cannot be less than 1
+   */
+  static S21Matrix Filled(int rows, int cols, double value);
+  /**
+   * Skips the zeroing pass, every value must be written before it is read
+   * @throws CreationError: The number of rows or cols cannot be less than 1
+   */
+  static S21Matrix Uninitialized(int rows, int cols);
+  /**
+   * Copies the values, row i starts at data + i * stride
+   * @throws CreationError: The number of rows or cols cannot be less than 1,
+   * the stride cannot be less than the number of cols, no data
+   */
+  static S21Matrix FromBuffer(const double* data, int rows, int cols,
+                              int stride);
+  /**
+   * Takes over rows * cols row-major values allocated with new[] without
+   * copying them
+   * @throws CreationError: The number of rows or cols cannot be less than 1,
+   * no data
+   */
+  static S21Matrix FromBuffer(std::unique_ptr<double[]> data, int rows,
+                              int cols);
+  /**
+   * Every value is drawn from its own counter-based stream: value (i, j)
+   * depends only on the seed and i * cols + j. Large matrices are filled by
+   * the threads of the library pool with the same result as a single thread.
+   * @throws CreationError: The number of rows or cols cannot be less than 1
+   */
+  static S21Matrix Random(int rows, int cols, const Distribution& distribution,
+                          std::uint64_t seed);
+
   // Assignment operators
 
   S21Matrix& operator=(const S21Matrix& other);
@@ -46,26 +117,79 @@ class S21Matrix {
    */
   void SetCols(int cols);
 
+  // Copy-on-write
+
+  /**
+   * When enabled, copies of this matrix share its storage and the deep copy
+   * is postponed until one of the owners is modified. The mode is inherited
+   * by copies; disabling it detaches the matrix from shared storage. Once a
+   * mutable reference, row or iterator has been taken, later copies are
+   * deep until the matrix is resized or reassigned, so the reference keeps
+   * writing to this matrix only. References taken before copy-on-write was
+   * enabled do not get this guarantee.
+   */
+  void SetCopyOnWrite(bool enabled);
+  bool IsCopyOnWrite() const;
+  bool IsShared() const;
+  /**
+   * Makes the storage unique, e.g. before handing the matrix to another thread
+   */
+  void Detach();
+
   // Overload operators
 
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
+  S21Matrix operator+(const S21Matrix& other) const;
+  S21Matrix operator-(const S21Matrix& other) const;
+  S21Matrix operator*(const S21Matrix& other) const;
   S21Matrix operator*(double num) const;
-  friend S21Matrix operator*(double, S21Matrix& matrix);
-  bool operator==(const S21Matrix& other);
+  friend S21Matrix operator*(double, const S21Matrix& matrix);
   /**
+   * @throws GemvError: Incorrect dimensions of the vectors
+   */
+  S21Vector operator*(const S21Vector& x) const;
+  bool operator==(const S21Matrix& other) const;
+  /**
+   * Detaches shared copy-on-write storage and keeps later copies from
+   * sharing it, see SetCopyOnWrite
    * @throws InvalidIndexError: Index is out of range
    */
   double& operator()(int row, int col);
   /**
    * @throws InvalidIndexError: Index is out of range
    */
-  double& operator()(int row, int col) const;
+  const double& operator()(int row, int col) const;
+
+  // Fast access
+
+  /**
+   * Unchecked element access for hot loops. The index is asserted, which
+   * the default build keeps; define NDEBUG for the code calling At, e.g.
+   * make RELEASE=1, to drop the check. Still detaches shared copy-on-write
+   * storage and keeps later copies from sharing it like operator(), prefer
+   * Row or begin to take that out of the inner loop.
+   */
+  double& At(int row, int col);
+  const double& At(int row, int col) const;
+  /**
+   * The cols values of a row, valid until the matrix is resized or
+   * reassigned
+   * @throws InvalidIndexError: Index is out of range
+   */
+  S21Span<double> Row(int row);
+  S21Span<const double> Row(int row) const;
+  // all values in row-major order, the storage is contiguous
+  double* begin();
+  double* end();
+  const double* begin() const;
+  const double* end() const;
 
   // Member functions
 
-  bool EqMatrix(const S21Matrix& other);
+  /**
+   * Matrices are equal when their dimensions match and every pair of values
+   * differs by at most kEqPrecision. A NaN is not equal to anything
+   */
+  bool EqMatrix(const S21Matrix& other) const;
   /**
    * @throws SumMatrixError: Matrices of different dimensions
    */
@@ -80,31 +204,193 @@ class S21Matrix {
    */
   void MulMatrix(const S21Matrix& other);
 
-  S21Matrix Transpose();
+  S21Matrix Transpose() const;
   /**
    * @throws CalcComplementsError: The matrix must be square
    */
-  S21Matrix CalcComplements();
+  S21Matrix CalcComplements() const;
   /**
    * @throws DeterminantError: The matrix must be square
    */
-  double Determinant();
+  double Determinant() const;
   /**
    * @throws InverseError: Incompatible matrix sizes to search inverse matrix
    */
-  S21Matrix InverseMatrix();
+  S21Matrix InverseMatrix() const;
+  /**
+   * Solves this * X = b by LU decomposition with partial pivoting
+   * @throws SolveError: The matrix must be square and non-singular, b must
+   * have as many rows as the matrix
+   */
+  S21Matrix Solve(const S21Matrix& b) const;
+  /**
+   * Raises the matrix to the k-th power with O(log k) multiplications,
+   * a negative power is the power of the inverse matrix
+   * @throws PowError: The matrix must be square
+   * @throws SolveError: for k < 0 if the matrix is singular
+   */
+  S21Matrix Pow(int k) const;
+  /**
+   * Matrix exponential by scaling and squaring of a Pade approximant
+   * @throws ExpError: The matrix must be square
+   * @throws ExpError: The matrix must be finite
+   */
+  S21Matrix Exp() const;
+  /**
+   * y = alpha * this * x + beta * y, large matrices are split by rows
+   * between the threads of the library pool
+   * @throws GemvError: Incorrect dimensions of the vectors
+   */
+  void Gemv(double alpha, const S21Vector& x, double beta, S21Vector& y) const;
+  /**
+   * y = alpha * x * this + beta * y for row vectors x and y, large matrices
+   * are split by columns between the threads of the library pool
+   * @throws GevmError: Incorrect dimensions of the vectors
+   */
+  void Gevm(double alpha, const S21Vector& x, double beta, S21Vector& y) const;
+
+  // Reductions
+
+  // The sums are compensated and large matrices are split between the threads
+  // of the library pool in blocks fixed by the shape, so the results do not
+  // depend on the number of threads.
+
+  /**
+   * @throws TraceError: The matrix must be square
+   */
+  double Trace() const;
+  double Sum() const;
+  double NormFrobenius() const;
+  // the largest sum of absolute values in a column
+  double Norm1() const;
+  // the largest sum of absolute values in a row
+  double NormInf() const;
+  double MaxAbs() const;
+  S21Vector RowSums() const;
+  S21Vector ColSums() const;
 
  private:
+  // structured types and the incremental inverse work on the row storage
+  friend class S21SymmetricMatrix;
+  friend class S21TriangularMatrix;
+  friend class S21BandMatrix;
+  friend class S21IncrementalInverse;
+  friend class S21MatrixCache;
+
+  // lives in front of the row pointers, counts owners of the storage
+  struct alignas(std::max_align_t) SharedHeader {
+    std::atomic<int> refs;
+    double* values;  // contiguous row-major values
+    bool adopted;    // values come from FromBuffer and are freed with delete[]
+    // a mutable reference into values was handed out, copies must be deep
+    bool unshareable;
+  };
+
   int rows_, cols_;
   double** matrix_;
+  SharedHeader* header_;
+  bool cow_;
 
-  void AllocateMemory();
+  // adopts the values allocated with new[], or leaves the values of a new
+  // block uninitialized for nullptr
+  S21Matrix(int rows, int cols, double* values);
+  void AllocateMemory(bool zeroed = true);
+  void AdoptMemory(double* values);
   void FreeMemory();
+  static void ReleaseMemory(SharedHeader* header);
+  void ShareMemory(const S21Matrix& other);
   void CopyValues(const S21Matrix& other);
-  S21Matrix Minor(int ex_row, int ex_col);
-  bool IsMatrixSameDimension(S21Matrix matrix);
-  bool IsMatrixSquare();
+  S21Matrix Minor(int ex_row, int ex_col) const;
+  // res = a * b with the shared Gemm kernel, res must not be a or b
+  static void MulInto(const S21Matrix& a, const S21Matrix& b, S21Matrix& res);
+  /**
+   * LU decomposition with partial pivoting into lu, returns the sign of the
+   * row permutation or 0 for a singular matrix
+   */
+  int Factorize(S21Matrix& lu, std::vector<int>& pivots) const;
+  static S21Matrix SolveFactorized(const S21Matrix& lu,
+                                   const std::vector<int>& pivots,
+                                   const S21Matrix& b);
+  void SetIdentity();
+  // compensated sums of transform(value) along the rows or the cols
+  template <typename Transform>
+  void SumRowsInto(Transform transform, S21Vector& sums) const;
+  template <typename Transform>
+  void SumColsInto(Transform transform, S21Vector& sums) const;
+  // first value of the contiguous storage, row pointers may be permuted
+  double* Values() const;
+  // Detach for the writers; storage is only ever shared with copy-on-write
+  void PrepareWrite();
+  // PrepareWrite for the accessors handing out mutable references
+  void PrepareReference();
+  bool CanShare() const;
+  bool IsMatrixSameDimension(const S21Matrix& matrix) const;
+  bool IsMatrixSquare() const;
 };
+
+// the fast accessors are inline to let the compiler drop them into loops
+
+inline double& S21Matrix::At(int row, int col) {
+  assert(row >= 0 && col >= 0 && row < rows_ && col < cols_);
+  PrepareReference();
+  return matrix_[row][col];
+}
+
+inline const double& S21Matrix::At(int row, int col) const {
+  assert(row >= 0 && col >= 0 && row < rows_ && col < cols_);
+  return matrix_[row][col];
+}
+
+inline S21Span<double> S21Matrix::Row(int row) {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  PrepareReference();
+  return S21Span<double>(matrix_[row], cols_);
+}
+
+inline S21Span<const double> S21Matrix::Row(int row) const {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  return S21Span<const double>(matrix_[row], cols_);
+}
+
+inline double* S21Matrix::begin() {
+  PrepareReference();
+  return Values();
+}
+
+inline double* S21Matrix::end() {
+  return begin() + static_cast<std::size_t>(rows_) * cols_;
+}
+
+inline const double* S21Matrix::begin() const { return Values(); }
+
+inline const double* S21Matrix::end() const {
+  return begin() + static_cast<std::size_t>(rows_) * cols_;
+}
+
+inline double* S21Matrix::Values() const {
+  return header_ ? header_->values : nullptr;
+}
+
+// the call to Detach is left for storage that is actually shared
+inline void S21Matrix::PrepareWrite() {
+  if (cow_ && header_ && header_->refs.load(std::memory_order_acquire) > 1) {
+    Detach();
+  }
+}
+
+// as std::string copy-on-write implementations did for operator[]
+inline void S21Matrix::PrepareReference() {
+  if (cow_ && header_) {
+    PrepareWrite();
+    header_->unshareable = true;
+  }
+}
 }  // namespace s_21
 
 #endif  // CPP1_S21_MATRIXPLUS_SRC_S21_MATRIX_OOP_H_
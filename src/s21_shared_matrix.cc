@@ -0,0 +1,285 @@
+#include "s21_shared_matrix.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <system_error>
+#include <thread>
+
+namespace s_21 {
+namespace {
+constexpr char kMagic[8] = {'S', '2', '1', 'S', 'H', 'A', 'R', 'E'};
+
+[[noreturn]] void ThrowSystemError(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(),
+                          "SharedMatrixError: " + what);
+}
+}  // namespace
+
+// The counter is a sequence lock: odd while the publisher writes the values,
+// a publication adds 2. The values start at 64 bytes, on a cache line.
+struct S21SharedMatrix::SegmentHeader {
+  char magic[8];
+  std::int32_t rows;
+  std::int32_t cols;
+  std::atomic<std::uint64_t> sequence;
+  char reserved[40];
+};
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "the counter must be a plain word shared between processes");
+
+namespace {
+std::size_t SegmentSize(int rows, int cols, std::size_t header_size) {
+  return header_size + static_cast<std::size_t>(rows) * cols * sizeof(double);
+}
+}  // namespace
+
+// CONSTRUCTORS
+
+S21SharedMatrix::S21SharedMatrix(const std::string& name,
+                                 const S21Matrix& matrix)
+    : name_(name),
+      rows_(matrix.GetRows()),
+      cols_(matrix.GetCols()),
+      publisher_(true),
+      map_(nullptr),
+      map_size_(0),
+      header_(nullptr),
+      values_(nullptr) {
+  if (name.size() < 2 || name[0] != '/') {
+    throw std::invalid_argument(
+        "SharedMatrixError: The name must start with '/'");
+  }
+
+  // never reuse a segment: readers of an old one would see it resized
+  int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) {
+    ThrowSystemError("Cannot create " + name);
+  }
+  std::size_t size = SegmentSize(rows_, cols_, sizeof(SegmentHeader));
+  try {
+    if (::ftruncate(fd, size) != 0) {
+      ThrowSystemError("Cannot resize " + name);
+    }
+    Map(fd, size, true);
+  } catch (...) {
+    ::close(fd);
+    ::shm_unlink(name.c_str());
+    throw;
+  }
+  ::close(fd);
+
+  header_ = new (map_) SegmentHeader{{}, rows_, cols_, {0}, {}};
+  std::memcpy(header_->magic, kMagic, sizeof(kMagic));
+  std::copy(matrix.begin(), matrix.end(), values_);
+  header_->sequence.store(2, std::memory_order_release);
+}
+
+S21SharedMatrix::S21SharedMatrix(const std::string& name)
+    : name_(name),
+      rows_(0),
+      cols_(0),
+      publisher_(false),
+      map_(nullptr),
+      map_size_(0),
+      header_(nullptr),
+      values_(nullptr) {
+  int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    ThrowSystemError("Cannot open " + name);
+  }
+  try {
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      ThrowSystemError("Cannot stat " + name);
+    }
+    if (static_cast<std::size_t>(info.st_size) < sizeof(SegmentHeader)) {
+      throw std::runtime_error("SharedMatrixError: Not published yet " + name);
+    }
+    Map(fd, info.st_size, false);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+
+  if (header_->sequence.load(std::memory_order_acquire) == 0) {
+    Unmap();
+    throw std::runtime_error("SharedMatrixError: Not published yet " + name);
+  }
+  if (std::memcmp(header_->magic, kMagic, sizeof(kMagic)) ||
+      header_->rows <= 0 || header_->cols <= 0 ||
+      SegmentSize(header_->rows, header_->cols, sizeof(SegmentHeader)) !=
+          map_size_) {
+    Unmap();
+    throw std::runtime_error("SharedMatrixError: Not a matrix segment " +
+                             name);
+  }
+  rows_ = header_->rows;
+  cols_ = header_->cols;
+}
+
+S21SharedMatrix::S21SharedMatrix(S21SharedMatrix&& other) noexcept
+    : name_(std::move(other.name_)),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      publisher_(other.publisher_),
+      map_(other.map_),
+      map_size_(other.map_size_),
+      header_(other.header_),
+      values_(other.values_) {
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.publisher_ = false;
+  other.map_ = nullptr;
+  other.map_size_ = 0;
+  other.header_ = nullptr;
+  other.values_ = nullptr;
+}
+
+// ASSIGNMENT OPERATORS
+
+S21SharedMatrix& S21SharedMatrix::operator=(S21SharedMatrix&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    name_ = std::move(other.name_);
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    publisher_ = other.publisher_;
+    map_ = other.map_;
+    map_size_ = other.map_size_;
+    header_ = other.header_;
+    values_ = other.values_;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.publisher_ = false;
+    other.map_ = nullptr;
+    other.map_size_ = 0;
+    other.header_ = nullptr;
+    other.values_ = nullptr;
+  }
+
+  return *this;
+}
+
+// DESTRUCTOR
+
+S21SharedMatrix::~S21SharedMatrix() { Unmap(); }
+
+// GETTERS
+
+int S21SharedMatrix::GetRows() const { return rows_; }
+
+int S21SharedMatrix::GetCols() const { return cols_; }
+
+const std::string& S21SharedMatrix::GetName() const { return name_; }
+
+bool S21SharedMatrix::IsPublisher() const { return publisher_; }
+
+std::uint64_t S21SharedMatrix::GetGeneration() const {
+  return header_ ? header_->sequence.load(std::memory_order_acquire) / 2 : 0;
+}
+
+// OVERLOAD OPERATORS
+
+const double& S21SharedMatrix::operator()(int row, int col) const {
+  if (row < 0 || col < 0 || row >= rows_ || col >= cols_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  return values_[static_cast<std::size_t>(row) * cols_ + col];
+}
+
+// MEMBER FUNCTIONS
+
+S21Span<const double> S21SharedMatrix::Row(int row) const {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  return S21Span<const double>(values_ + static_cast<std::size_t>(row) * cols_,
+                               cols_);
+}
+
+const double* S21SharedMatrix::begin() const { return values_; }
+
+const double* S21SharedMatrix::end() const {
+  return values_ + static_cast<std::size_t>(rows_) * cols_;
+}
+
+void S21SharedMatrix::Update(const S21Matrix& matrix) {
+  if (!publisher_) {
+    throw std::logic_error(
+        "SharedMatrixError: Only the publisher can update the matrix");
+  }
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::range_error(
+        "SharedMatrixError: Matrices of different dimensions");
+  }
+
+  std::uint64_t sequence = header_->sequence.load(std::memory_order_relaxed);
+  header_->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::copy(matrix.begin(), matrix.end(), values_);
+  header_->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+S21Matrix S21SharedMatrix::ToMatrix() const {
+  S21Matrix copy(rows_, cols_);
+  while (true) {
+    std::uint64_t before = header_->sequence.load(std::memory_order_acquire);
+    if (before % 2) {
+      std::this_thread::yield();
+      continue;
+    }
+    std::copy(begin(), end(), copy.begin());
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header_->sequence.load(std::memory_order_relaxed) == before) {
+      return copy;
+    }
+  }
+}
+
+bool S21SharedMatrix::Unlink(const std::string& name) {
+  return ::shm_unlink(name.c_str()) == 0;
+}
+
+// PRIVATE MEMBER FUNCTIONS
+
+void S21SharedMatrix::Map(int fd, std::size_t size, bool writable) {
+  static_assert(sizeof(SegmentHeader) == 64,
+                "the values must start at 64 bytes");
+  int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+  void* map = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    ThrowSystemError("Cannot map " + name_);
+  }
+
+  map_ = map;
+  map_size_ = size;
+  header_ = static_cast<SegmentHeader*>(map);
+  values_ = reinterpret_cast<double*>(static_cast<char*>(map) +
+                                      sizeof(SegmentHeader));
+}
+
+void S21SharedMatrix::Unmap() {
+  if (!map_) {
+    return;
+  }
+
+  ::munmap(map_, map_size_);
+  if (publisher_) {
+    ::shm_unlink(name_.c_str());
+  }
+  map_ = nullptr;
+  map_size_ = 0;
+  header_ = nullptr;
+  values_ = nullptr;
+}
+
+}  // namespace s_21
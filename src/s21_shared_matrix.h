@@ -0,0 +1,107 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_SHARED_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_SHARED_MATRIX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "s21_matrix_oop.h"
+#include "s21_span.h"
+
+namespace s_21 {
+// Matrix in named POSIX shared memory for processes on one host. One process
+// publishes the values under a name like "/weights", the others attach to the
+// same pages read-only and read them in place. Every update bumps a
+// generation counter in the segment header, so readers can tell that the
+// values changed and take consistent snapshots while the publisher writes.
+class S21SharedMatrix {
+ public:
+  // Constructors
+
+  /**
+   * Publishes a copy of the matrix in a new segment, the segment is removed
+   * when the publisher is destroyed, attached readers keep their mapping
+   * @throws SharedMatrixError: The name must start with '/', the segment
+   * already exists or cannot be created
+   */
+  S21SharedMatrix(const std::string& name, const S21Matrix& matrix);
+  /**
+   * Attaches read-only to a published segment
+   * @throws SharedMatrixError: the segment does not exist, is not published
+   * yet or is not a matrix segment
+   */
+  explicit S21SharedMatrix(const std::string& name);
+  S21SharedMatrix(const S21SharedMatrix& other) = delete;
+  S21SharedMatrix(S21SharedMatrix&& other) noexcept;
+
+  // Assignment operators
+
+  S21SharedMatrix& operator=(const S21SharedMatrix& other) = delete;
+  S21SharedMatrix& operator=(S21SharedMatrix&& other) noexcept;
+
+  // Destructor
+
+  ~S21SharedMatrix();
+
+  // Getters
+
+  int GetRows() const;
+  int GetCols() const;
+  const std::string& GetName() const;
+  bool IsPublisher() const;
+  /**
+   * Number of completed publications, 1 right after the first one
+   */
+  std::uint64_t GetGeneration() const;
+
+  // Overload operators
+
+  /**
+   * Reads the shared pages directly, see ToMatrix for a consistent copy
+   * @throws InvalidIndexError: Index is out of range
+   */
+  const double& operator()(int row, int col) const;
+
+  // Member functions
+
+  /**
+   * @throws InvalidIndexError: Index is out of range
+   */
+  S21Span<const double> Row(int row) const;
+  const double* begin() const;
+  const double* end() const;
+  /**
+   * Publishes new values of the same dimensions and bumps the generation
+   * @throws SharedMatrixError: Only the publisher can update the matrix
+   * @throws SharedMatrixError: Matrices of different dimensions
+   */
+  void Update(const S21Matrix& matrix);
+  /**
+   * Copy of one complete generation, waits out an update in progress
+   */
+  S21Matrix ToMatrix() const;
+  /**
+   * Removes a segment left behind by a publisher that did not exit cleanly,
+   * returns false if there is no such segment
+   */
+  static bool Unlink(const std::string& name);
+
+ private:
+  struct SegmentHeader;
+
+  std::string name_;
+  int rows_, cols_;
+  bool publisher_;
+  void* map_;
+  std::size_t map_size_;
+  SegmentHeader* header_;
+  double* values_;
+
+  void Map(int fd, std::size_t size, bool writable);
+  void Unmap();
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_SHARED_MATRIX_H_
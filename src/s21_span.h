@@ -0,0 +1,26 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_SPAN_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_SPAN_H_
+
+namespace s_21 {
+// Non-owning view of contiguous values, a C++17 stand-in for std::span
+template <typename T>
+class S21Span {
+ public:
+  S21Span(T* data, int size) : data_(data), size_(size) {}
+
+  T* begin() const { return data_; }
+  T* end() const { return data_ + size_; }
+  T* data() const { return data_; }
+  int size() const { return size_; }
+  // unchecked, as std::span
+  T& operator[](int index) const { return data_[index]; }
+
+ private:
+  T* data_;
+  int size_;
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_SPAN_H_
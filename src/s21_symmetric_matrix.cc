@@ -0,0 +1,125 @@
+#include "s21_symmetric_matrix.h"
+
+namespace s_21 {
+// CONSTRUCTORS
+
+S21SymmetricMatrix::S21SymmetricMatrix(int size) : size_(size) {
+  if (size <= 0) {
+    throw std::invalid_argument(
+        "CreationError: The size cannot be less than 1");
+  }
+  data_.assign(Index(size_, 0), 0);
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix(const S21Matrix& matrix)
+    : size_(matrix.rows_) {
+  if (!matrix.IsMatrixSquare() || size_ <= 0) {
+    throw std::range_error("ConversionError: The matrix must be square");
+  }
+
+  data_.resize(Index(size_, 0));
+  for (int i = 0; i < size_; i++) {
+    std::memcpy(&data_[Index(i, 0)], matrix.matrix_[i],
+                (i + 1) * sizeof(double));
+  }
+}
+
+// GETTERS
+
+int S21SymmetricMatrix::GetSize() const { return size_; }
+
+// OVERLOAD OPERATORS
+
+double& S21SymmetricMatrix::operator()(int row, int col) {
+  if (row < 0 || col < 0 || row >= size_ || col >= size_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  return row >= col ? data_[Index(row, col)] : data_[Index(col, row)];
+}
+
+const double& S21SymmetricMatrix::operator()(int row, int col) const {
+  if (row < 0 || col < 0 || row >= size_ || col >= size_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  return row >= col ? data_[Index(row, col)] : data_[Index(col, row)];
+}
+
+// MEMBER FUNCTIONS
+
+S21Matrix S21SymmetricMatrix::ToMatrix() const {
+  S21Matrix matrix(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    const double* row = &data_[Index(i, 0)];
+    for (int j = 0; j <= i; j++) {
+      matrix.matrix_[i][j] = row[j];
+      matrix.matrix_[j][i] = row[j];
+    }
+  }
+
+  return matrix;
+}
+
+void S21SymmetricMatrix::Gemv(double alpha, const S21Vector& x, double beta,
+                              S21Vector& y) const {
+  if (x.size_ != size_ || y.size_ != size_) {
+    throw std::range_error("GemvError: Incorrect dimensions of the vectors");
+  }
+
+  S21Vector product(size_);
+  double* res = product.data_;
+  const double* x_data = x.data_;
+  // a stored a_ij (j < i) contributes to both y_i and y_j
+  for (int i = 0; i < size_; i++) {
+    const double* row = &data_[Index(i, 0)];
+    double x_i = x_data[i];
+    double sum = 0;
+    for (int j = 0; j < i; j++) {
+      sum += row[j] * x_data[j];
+      res[j] += row[j] * x_i;
+    }
+    res[i] += sum + row[i] * x_i;
+  }
+
+  for (int i = 0; i < size_; i++) {
+    y.data_[i] =
+        beta == 0 ? alpha * res[i] : alpha * res[i] + beta * y.data_[i];
+  }
+}
+
+S21Matrix S21SymmetricMatrix::MulMatrix(const S21Matrix& other) const {
+  if (other.rows_ != size_) {
+    throw std::range_error(
+        "MulMatrixError: Incorrect dimensions to multiply two matrices");
+  }
+
+  S21Matrix res_matrix(size_, other.cols_);
+  for (int i = 0; i < size_; i++) {
+    const double* row = &data_[Index(i, 0)];
+    double* res_i = res_matrix.matrix_[i];
+    const double* other_i = other.matrix_[i];
+    for (int j = 0; j < i; j++) {
+      double a_ij = row[j];
+      double* res_j = res_matrix.matrix_[j];
+      const double* other_j = other.matrix_[j];
+      for (int k = 0; k < other.cols_; k++) {
+        res_i[k] += a_ij * other_j[k];
+        res_j[k] += a_ij * other_i[k];
+      }
+    }
+    for (int k = 0; k < other.cols_; k++) {
+      res_i[k] += row[i] * other_i[k];
+    }
+  }
+
+  return res_matrix;
+}
+
+// PRIVATE MEMBER FUNCTIONS
+
+std::size_t S21SymmetricMatrix::Index(int row, int col) {
+  return static_cast<std::size_t>(row) * (row + 1) / 2 + col;
+}
+
+}  // namespace s_21
@@ -0,0 +1,65 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_SYMMETRIC_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_SYMMETRIC_MATRIX_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_vector.h"
+
+namespace s_21 {
+// Square symmetric matrix, only the lower triangle is stored (n(n+1)/2 values)
+class S21SymmetricMatrix {
+ public:
+  // Constructors
+
+  /**
+   * @throws CreationError: The size cannot be less than 1
+   */
+  explicit S21SymmetricMatrix(int size);
+  /**
+   * Takes the lower triangle of the matrix, the upper one is not read
+   * @throws ConversionError: The matrix must be square
+   */
+  explicit S21SymmetricMatrix(const S21Matrix& matrix);
+
+  // Getters
+
+  int GetSize() const;
+
+  // Overload operators
+
+  /**
+   * (row, col) and (col, row) refer to the same value
+   * @throws InvalidIndexError: Index is out of range
+   */
+  double& operator()(int row, int col);
+  /**
+   * @throws InvalidIndexError: Index is out of range
+   */
+  const double& operator()(int row, int col) const;
+
+  // Member functions
+
+  S21Matrix ToMatrix() const;
+  /**
+   * y = alpha * this * x + beta * y, every stored value is read once
+   * @throws GemvError: Incorrect dimensions of the vectors
+   */
+  void Gemv(double alpha, const S21Vector& x, double beta, S21Vector& y) const;
+  /**
+   * Returns this * other, every stored value is read once per other column
+   * @throws MulMatrixError: Incorrect dimensions to multiply two matrices
+   */
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+
+ private:
+  int size_;
+  std::vector<double> data_;
+
+  static std::size_t Index(int row, int col);
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_SYMMETRIC_MATRIX_H_
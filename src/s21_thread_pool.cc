@@ -0,0 +1,119 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace s_21 {
+// CONSTRUCTORS
+
+S21ThreadPool::S21ThreadPool(int threads_count) : stop_(false) {
+  if (threads_count <= 0) {
+    throw std::invalid_argument(
+        "CreationError: The number of threads cannot be less than 1");
+  }
+
+  workers_.reserve(threads_count);
+  for (int i = 0; i < threads_count; i++) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this);
+  }
+}
+
+// DESTRUCTOR
+
+S21ThreadPool::~S21ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  tasks_cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+// GETTERS
+
+S21ThreadPool& S21ThreadPool::Instance() {
+  static S21ThreadPool pool(
+      std::thread::hardware_concurrency() ? std::thread::hardware_concurrency()
+                                          : 1);
+  return pool;
+}
+
+int S21ThreadPool::GetThreadsCount() const { return workers_.size(); }
+
+// MEMBER FUNCTIONS
+
+void S21ThreadPool::Submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push(std::move(task));
+  }
+  tasks_cv_.notify_one();
+}
+
+void S21ThreadPool::ParallelFor(int begin, int end, int grain,
+                                const std::function<void(int, int)>& body) {
+  if (end <= begin) {
+    return;
+  }
+  grain = std::max(grain, 1);
+  int chunks_count = (end - begin - 1) / grain + 1;
+  if (chunks_count == 1) {
+    body(begin, end);
+    return;
+  }
+
+  struct Loop {
+    std::atomic<int> next_chunk{0};
+    int finished_chunks = 0;
+    std::mutex mutex;
+    std::condition_variable finished_cv;
+  };
+  auto loop = std::make_shared<Loop>();
+  // a helper that starts after the last chunk was taken never touches body
+  auto run_chunks = [loop, &body, begin, end, grain, chunks_count] {
+    for (int chunk = loop->next_chunk++; chunk < chunks_count;
+         chunk = loop->next_chunk++) {
+      int from = begin + chunk * grain;
+      body(from, std::min(end, from + grain));
+      std::lock_guard<std::mutex> lock(loop->mutex);
+      if (++loop->finished_chunks == chunks_count) {
+        loop->finished_cv.notify_all();
+      }
+    }
+  };
+
+  int helpers_count = std::min<int>(chunks_count - 1, workers_.size());
+  for (int i = 0; i < helpers_count; i++) {
+    Submit(run_chunks);
+  }
+  run_chunks();
+
+  std::unique_lock<std::mutex> lock(loop->mutex);
+  loop->finished_cv.wait(lock, [&loop, chunks_count] {
+    return loop->finished_chunks == chunks_count;
+  });
+}
+
+// PRIVATE MEMBER FUNCTIONS
+
+void S21ThreadPool::WorkerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      tasks_cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
+}  // namespace s_21
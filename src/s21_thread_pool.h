@@ -0,0 +1,67 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_THREAD_POOL_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace s_21 {
+class S21ThreadPool {
+ public:
+  // Constructors
+
+  /**
+   * @throws CreationError: The number of threads cannot be less than 1
+   */
+  explicit S21ThreadPool(int threads_count);
+  S21ThreadPool(const S21ThreadPool& other) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool& other) = delete;
+
+  // Destructor
+
+  /**
+   * Finishes the queued tasks and joins the workers
+   */
+  ~S21ThreadPool();
+
+  // Getters
+
+  /**
+   * Library wide pool with one worker per hardware thread
+   */
+  static S21ThreadPool& Instance();
+  int GetThreadsCount() const;
+
+  // Member functions
+
+  /**
+   * Queues the task for one of the workers. Tasks must not throw and must not
+   * block waiting for other tasks of the same pool.
+   */
+  void Submit(std::function<void()> task);
+  /**
+   * Splits [begin, end) into chunks of grain indexes and runs body(from, to)
+   * for every chunk on the workers and on the calling thread. Returns when all
+   * chunks are done; the caller takes chunks itself, so it is safe to call
+   * from a pool task. The body must not throw.
+   */
+  void ParallelFor(int begin, int end, int grain,
+                   const std::function<void(int, int)>& body);
+
+ private:
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable tasks_cv_;
+  bool stop_;
+
+  void WorkerLoop();
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_THREAD_POOL_H_
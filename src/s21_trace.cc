@@ -0,0 +1,194 @@
+#include "s21_trace.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+
+namespace s_21 {
+namespace {
+constexpr char kMagic[8] = {'S', '2', '1', 'T', 'R', 'A', 'C', 'E'};
+constexpr std::uint32_t kVersion = 1;
+// records are written in batches of 100 KiB
+constexpr std::size_t kBufferRecords = 2560;
+
+static_assert(sizeof(S21TraceRecord) == 40,
+              "the records are written to the file as they are");
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t record_size;
+};
+
+// The file of the running recording, a recording still running when the
+// process exits is completed by the destructor
+struct Recording {
+  std::mutex mutex;
+  std::FILE* file = nullptr;
+  std::chrono::steady_clock::time_point epoch;
+  std::vector<S21TraceRecord> buffer;
+
+  ~Recording() { Close(); }
+
+  // a failed write loses the batch, tracing never fails the traced call
+  void Flush() {
+    if (!buffer.empty()) {
+      std::fwrite(buffer.data(), sizeof(S21TraceRecord), buffer.size(), file);
+      buffer.clear();
+    }
+  }
+
+  void Close() {
+    if (file) {
+      Flush();
+      std::fclose(file);
+      file = nullptr;
+    }
+  }
+};
+
+Recording& GetRecording() {
+  static Recording recording;
+  return recording;
+}
+
+[[noreturn]] void ThrowSystemError(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(),
+                          "TraceError: " + what);
+}
+
+std::uint64_t Nanoseconds(std::chrono::steady_clock::duration duration) {
+  auto count =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  return count > 0 ? count : 0;
+}
+}  // namespace
+
+// RECORDER
+
+void S21TraceRecorder::Start(const std::string& path) {
+  Recording& recording = GetRecording();
+  std::lock_guard<std::mutex> lock(recording.mutex);
+  if (recording.file) {
+    throw std::logic_error("TraceError: A recording is already running");
+  }
+
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    ThrowSystemError("Cannot create " + path);
+  }
+  FileHeader header{{}, kVersion, sizeof(S21TraceRecord)};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+    std::fclose(file);
+    ThrowSystemError("Cannot write " + path);
+  }
+
+  recording.file = file;
+  recording.buffer.reserve(kBufferRecords);
+  recording.epoch = std::chrono::steady_clock::now();
+  recording_.store(true, std::memory_order_relaxed);
+}
+
+void S21TraceRecorder::Stop() {
+  recording_.store(false, std::memory_order_relaxed);
+  Recording& recording = GetRecording();
+  std::lock_guard<std::mutex> lock(recording.mutex);
+  recording.Close();
+}
+
+std::vector<S21TraceRecord> S21TraceRecorder::Read(const std::string& path) {
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    ThrowSystemError("Cannot open " + path);
+  }
+
+  FileHeader header;
+  bool valid = std::fread(&header, sizeof(header), 1, file) == 1 &&
+               !std::memcmp(header.magic, kMagic, sizeof(kMagic)) &&
+               header.version == kVersion &&
+               header.record_size == sizeof(S21TraceRecord);
+  std::vector<S21TraceRecord> records;
+  S21TraceRecord record;
+  // a partial record at the end is left by a process that was killed
+  while (valid && std::fread(&record, sizeof(record), 1, file) == 1) {
+    valid = record.op < S21TraceOp::kCount && record.rows >= 0 &&
+            record.cols >= 0 && record.other_rows >= 0 &&
+            record.other_cols >= 0;
+    records.push_back(record);
+  }
+  std::fclose(file);
+  if (!valid) {
+    throw std::runtime_error("TraceError: Not a trace " + path);
+  }
+
+  return records;
+}
+
+const char* S21TraceRecorder::OpName(S21TraceOp op) {
+  static const char* const kNames[] = {
+      "SumMatrix",     "SubMatrix",     "MulNumber",    "MulMatrix",
+      "Transpose",     "CalcComplements", "Determinant", "InverseMatrix",
+      "Solve",         "Pow",           "Exp",          "Gemv",
+      "Gevm",          "Sum",           "Trace",        "NormFrobenius",
+      "Norm1",         "NormInf",       "MaxAbs",       "RowSums",
+      "ColSums",       "Identity",      "Filled",       "Random",
+      "FromBuffer",    "DominantEigen", "LanczosEigen", "RankOneUpdate",
+      "ReplaceRow",    "ReplaceCol",    "AppendRowCol"};
+  static_assert(sizeof(kNames) / sizeof(kNames[0]) ==
+                    static_cast<std::size_t>(S21TraceOp::kCount),
+                "every operation needs a name");
+
+  return op < S21TraceOp::kCount ? kNames[static_cast<int>(op)] : "Unknown";
+}
+
+void S21TraceRecorder::Record(S21TraceRecord record,
+                              std::chrono::steady_clock::time_point start,
+                              std::chrono::steady_clock::time_point end) {
+  Recording& recording = GetRecording();
+  std::lock_guard<std::mutex> lock(recording.mutex);
+  // the recording stopped during the call
+  if (!recording.file) {
+    return;
+  }
+
+  record.start_ns = Nanoseconds(start - recording.epoch);
+  record.duration_ns = Nanoseconds(end - start);
+  recording.buffer.push_back(record);
+  if (recording.buffer.size() >= kBufferRecords) {
+    recording.Flush();
+  }
+}
+
+// SCOPE
+
+S21TraceScope::S21TraceScope(S21TraceOp op, int rows, int cols,
+                             int other_rows, int other_cols, int argument)
+    : counted_(S21TraceRecorder::IsRecording()), outermost_(false) {
+  if (!counted_) {
+    return;
+  }
+
+  outermost_ = depth_++ == 0;
+  if (outermost_) {
+    record_ = {op, {}, rows, cols, other_rows, other_cols, argument, 0, 0};
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+S21TraceScope::~S21TraceScope() {
+  if (!counted_) {
+    return;
+  }
+
+  depth_--;
+  if (outermost_) {
+    S21TraceRecorder::Record(record_, start_,
+                             std::chrono::steady_clock::now());
+  }
+}
+
+}  // namespace s_21
@@ -0,0 +1,125 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_TRACE_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace s_21 {
+enum class S21TraceOp : std::uint8_t {
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kMulMatrix,
+  kTranspose,
+  kCalcComplements,
+  kDeterminant,
+  kInverseMatrix,
+  kSolve,
+  kPow,
+  kExp,
+  kGemv,
+  kGevm,
+  kSum,
+  kTrace,
+  kNormFrobenius,
+  kNorm1,
+  kNormInf,
+  kMaxAbs,
+  kRowSums,
+  kColSums,
+  kIdentity,
+  kFilled,
+  kRandom,
+  kFromBuffer,
+  kDominantEigen,
+  kLanczosEigen,
+  kRankOneUpdate,
+  kReplaceRow,
+  kReplaceCol,
+  kAppendRowCol,
+  kCount
+};
+
+// One library call as it is stored in the trace file, 40 bytes
+struct S21TraceRecord {
+  S21TraceOp op;
+  std::uint8_t reserved[3];
+  std::int32_t rows, cols;
+  // the second matrix operand, 0 x 0 when there is none
+  std::int32_t other_rows, other_cols;
+  // the power of Pow, the count of the eigensolvers, the stride of FromBuffer
+  std::int32_t argument;
+  // since the recording started
+  std::uint64_t start_ns;
+  std::uint64_t duration_ns;
+};
+
+// Opt-in recorder of the S21Matrix calls of a process. While a recording
+// runs, every call of the traced operations appends its operation, operand
+// shapes and wall time to a compact binary file; the calls these operations
+// make internally are not recorded. The s21_replay tool (make replay) runs a
+// trace again on random matrices of the same shapes. When nothing is being
+// recorded a traced call costs one relaxed atomic load.
+//
+// The traced operations are the S21TraceOp values: the S21Matrix
+// arithmetic, decompositions, products with vectors and reductions, the
+// factories that write every value, the eigensolvers, whose operator forms
+// are replayed on dense matrices, and the S21IncrementalInverse updates.
+// S21MatrixChain, the structured, disk and shared matrix types and the
+// cache are not traced, only the traced calls they make themselves are.
+class S21TraceRecorder {
+ public:
+  /**
+   * Starts recording to a new trace file, overwriting an existing one
+   * @throws TraceError: A recording is already running, the file cannot be
+   * created
+   */
+  static void Start(const std::string& path);
+  /**
+   * Writes the buffered records and closes the file, does nothing when no
+   * recording runs
+   */
+  static void Stop();
+  static bool IsRecording() {
+    return recording_.load(std::memory_order_relaxed);
+  }
+  /**
+   * @throws TraceError: The file cannot be read or is not a trace
+   */
+  static std::vector<S21TraceRecord> Read(const std::string& path);
+  static const char* OpName(S21TraceOp op);
+
+ private:
+  friend class S21TraceScope;
+
+  static void Record(S21TraceRecord record,
+                     std::chrono::steady_clock::time_point start,
+                     std::chrono::steady_clock::time_point end);
+
+  inline static std::atomic<bool> recording_{false};
+};
+
+// Records the enclosing call unless the thread is already inside a traced one
+class S21TraceScope {
+ public:
+  S21TraceScope(S21TraceOp op, int rows, int cols, int other_rows = 0,
+                int other_cols = 0, int argument = 0);
+  S21TraceScope(const S21TraceScope& other) = delete;
+  S21TraceScope& operator=(const S21TraceScope& other) = delete;
+  ~S21TraceScope();
+
+ private:
+  bool counted_, outermost_;
+  S21TraceRecord record_;
+  std::chrono::steady_clock::time_point start_;
+
+  inline static thread_local int depth_ = 0;
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_TRACE_H_
@@ -0,0 +1,158 @@
+#include "s21_triangular_matrix.h"
+
+namespace s_21 {
+// CONSTRUCTORS
+
+S21TriangularMatrix::S21TriangularMatrix(int size, Triangle triangle)
+    : size_(size), triangle_(triangle) {
+  if (size <= 0) {
+    throw std::invalid_argument(
+        "CreationError: The size cannot be less than 1");
+  }
+  data_.assign(RowOffset(size_), 0);
+}
+
+S21TriangularMatrix::S21TriangularMatrix(const S21Matrix& matrix,
+                                         Triangle triangle)
+    : size_(matrix.rows_), triangle_(triangle) {
+  if (!matrix.IsMatrixSquare() || size_ <= 0) {
+    throw std::range_error("ConversionError: The matrix must be square");
+  }
+
+  data_.resize(RowOffset(size_));
+  for (int i = 0; i < size_; i++) {
+    int first_col = FirstCol(i);
+    std::memcpy(&data_[RowOffset(i)], matrix.matrix_[i] + first_col,
+                (LastCol(i) - first_col + 1) * sizeof(double));
+  }
+}
+
+// GETTERS
+
+int S21TriangularMatrix::GetSize() const { return size_; }
+
+S21TriangularMatrix::Triangle S21TriangularMatrix::GetTriangle() const {
+  return triangle_;
+}
+
+// OVERLOAD OPERATORS
+
+double& S21TriangularMatrix::operator()(int row, int col) {
+  if (row < 0 || col < 0 || row >= size_ || col >= size_ ||
+      !IsInTriangle(row, col)) {
+    throw std::out_of_range(
+        "InvalidIndexError: Index is out of range or outside the triangle");
+  }
+
+  return data_[RowOffset(row) + col - FirstCol(row)];
+}
+
+const double& S21TriangularMatrix::operator()(int row, int col) const {
+  static const double kZero = 0;
+  if (row < 0 || col < 0 || row >= size_ || col >= size_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  return IsInTriangle(row, col) ? data_[RowOffset(row) + col - FirstCol(row)]
+                                : kZero;
+}
+
+// MEMBER FUNCTIONS
+
+S21Matrix S21TriangularMatrix::ToMatrix() const {
+  S21Matrix matrix(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    int first_col = FirstCol(i);
+    std::memcpy(matrix.matrix_[i] + first_col, &data_[RowOffset(i)],
+                (LastCol(i) - first_col + 1) * sizeof(double));
+  }
+
+  return matrix;
+}
+
+double S21TriangularMatrix::Determinant() const {
+  double det = 1;
+  for (int i = 0; i < size_; i++) {
+    det *= data_[RowOffset(i) + i - FirstCol(i)];
+  }
+
+  return det;
+}
+
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix& b) const {
+  if (b.rows_ != size_) {
+    throw std::range_error(
+        "SolveError: Incompatible matrix sizes to solve the system");
+  }
+
+  S21Matrix res_matrix(b);
+  res_matrix.Detach();
+  bool is_lower = triangle_ == Triangle::kLower;
+  // forward substitution for the lower triangle, backward for the upper one
+  for (int step = 0; step < size_; step++) {
+    int i = is_lower ? step : size_ - 1 - step;
+    const double* row = &data_[RowOffset(i)] - FirstCol(i);
+    double* x_i = res_matrix.matrix_[i];
+    for (int k = FirstCol(i); k <= LastCol(i); k++) {
+      if (k == i) {
+        continue;
+      }
+      const double* x_k = res_matrix.matrix_[k];
+      for (int j = 0; j < b.cols_; j++) {
+        x_i[j] -= row[k] * x_k[j];
+      }
+    }
+    if (row[i] == 0) {
+      throw std::range_error("SolveError: The matrix is singular");
+    }
+    for (int j = 0; j < b.cols_; j++) {
+      x_i[j] /= row[i];
+    }
+  }
+
+  return res_matrix;
+}
+
+void S21TriangularMatrix::Gemv(double alpha, const S21Vector& x, double beta,
+                               S21Vector& y) const {
+  if (x.size_ != size_ || y.size_ != size_) {
+    throw std::range_error("GemvError: Incorrect dimensions of the vectors");
+  }
+
+  S21Vector product(size_);
+  for (int i = 0; i < size_; i++) {
+    const double* row = &data_[RowOffset(i)] - FirstCol(i);
+    double sum = 0;
+    for (int j = FirstCol(i); j <= LastCol(i); j++) {
+      sum += row[j] * x.data_[j];
+    }
+    product.data_[i] = sum;
+  }
+
+  for (int i = 0; i < size_; i++) {
+    y.data_[i] = beta == 0 ? alpha * product.data_[i]
+                           : alpha * product.data_[i] + beta * y.data_[i];
+  }
+}
+
+// PRIVATE MEMBER FUNCTIONS
+
+bool S21TriangularMatrix::IsInTriangle(int row, int col) const {
+  return triangle_ == Triangle::kLower ? col <= row : col >= row;
+}
+
+int S21TriangularMatrix::FirstCol(int row) const {
+  return triangle_ == Triangle::kLower ? 0 : row;
+}
+
+int S21TriangularMatrix::LastCol(int row) const {
+  return triangle_ == Triangle::kLower ? row : size_ - 1;
+}
+
+std::size_t S21TriangularMatrix::RowOffset(int row) const {
+  std::size_t r = row;
+  return triangle_ == Triangle::kLower ? r * (r + 1) / 2
+                                       : r * size_ - r * (r - 1) / 2;
+}
+
+}  // namespace s_21
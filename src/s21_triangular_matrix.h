@@ -0,0 +1,77 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_TRIANGULAR_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_TRIANGULAR_MATRIX_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_vector.h"
+
+namespace s_21 {
+// Square triangular matrix, only the triangle is stored (n(n+1)/2 values)
+class S21TriangularMatrix {
+ public:
+  enum class Triangle { kLower, kUpper };
+
+  // Constructors
+
+  /**
+   * @throws CreationError: The size cannot be less than 1
+   */
+  S21TriangularMatrix(int size, Triangle triangle);
+  /**
+   * Takes the given triangle of the matrix, the other one is not read
+   * @throws ConversionError: The matrix must be square
+   */
+  S21TriangularMatrix(const S21Matrix& matrix, Triangle triangle);
+
+  // Getters
+
+  int GetSize() const;
+  Triangle GetTriangle() const;
+
+  // Overload operators
+
+  /**
+   * @throws InvalidIndexError: Index is out of range or outside the triangle
+   */
+  double& operator()(int row, int col);
+  /**
+   * Values outside the triangle read as zero
+   * @throws InvalidIndexError: Index is out of range
+   */
+  const double& operator()(int row, int col) const;
+
+  // Member functions
+
+  S21Matrix ToMatrix() const;
+  /**
+   * Product of the diagonal, O(n)
+   */
+  double Determinant() const;
+  /**
+   * Solves this * X = b by substitution, O(n^2) per column of b
+   * @throws SolveError: The matrix is singular or b has a wrong number of rows
+   */
+  S21Matrix Solve(const S21Matrix& b) const;
+  /**
+   * y = alpha * this * x + beta * y
+   * @throws GemvError: Incorrect dimensions of the vectors
+   */
+  void Gemv(double alpha, const S21Vector& x, double beta, S21Vector& y) const;
+
+ private:
+  int size_;
+  Triangle triangle_;
+  std::vector<double> data_;
+
+  bool IsInTriangle(int row, int col) const;
+  // first stored column of the row and its position in data_
+  int FirstCol(int row) const;
+  int LastCol(int row) const;
+  std::size_t RowOffset(int row) const;
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_TRIANGULAR_MATRIX_H_
@@ -0,0 +1,145 @@
+#include "s21_vector.h"
+
+#include <limits>
+#include <utility>
+
+namespace s_21 {
+// CONSTRUCTORS
+
+S21Vector::S21Vector(int size) : size_(size), data_(nullptr) {
+  if (size <= 0) {
+    throw std::invalid_argument(
+        "CreationError: The size cannot be less than 1");
+  }
+  data_ = new double[size_]();
+}
+
+S21Vector::S21Vector(const S21Vector& other)
+    : size_(other.size_), data_(new double[other.size_]) {
+  std::memcpy(data_, other.data_, size_ * sizeof(double));
+}
+
+S21Vector::S21Vector(S21Vector&& other) noexcept
+    : size_(other.size_), data_(other.data_) {
+  other.size_ = 0;
+  other.data_ = nullptr;
+}
+
+// ASSIGNMENT OPERATORS
+
+S21Vector& S21Vector::operator=(const S21Vector& other) {
+  if (this != &other) {
+    S21Vector tmp(other);
+    *this = std::move(tmp);
+  }
+
+  return *this;
+}
+
+S21Vector& S21Vector::operator=(S21Vector&& other) noexcept {
+  if (this != &other) {
+    delete[] data_;
+    size_ = other.size_;
+    data_ = other.data_;
+
+    other.size_ = 0;
+    other.data_ = nullptr;
+  }
+
+  return *this;
+}
+
+// DESTRUCTOR
+
+S21Vector::~S21Vector() { delete[] data_; }
+
+// GETTERS
+
+int S21Vector::GetSize() const { return size_; }
+
+// OVERLOAD OPERATORS
+
+double& S21Vector::operator()(int index) {
+  if (index < 0 || index >= size_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  return data_[index];
+}
+
+const double& S21Vector::operator()(int index) const {
+  if (index < 0 || index >= size_) {
+    throw std::out_of_range("InvalidIndexError: Index is out of range");
+  }
+
+  return data_[index];
+}
+
+// MEMBER FUNCTIONS
+
+double S21Vector::Dot(const S21Vector& other) const {
+  if (size_ != other.size_) {
+    throw std::range_error("DotError: Vectors of different sizes");
+  }
+
+  // independent partial sums let the compiler vectorize the reduction
+  double sum[4] = {0, 0, 0, 0};
+  int i = 0;
+  for (; i + 4 <= size_; i += 4) {
+    for (int lane = 0; lane < 4; lane++) {
+      sum[lane] += data_[i + lane] * other.data_[i + lane];
+    }
+  }
+  for (; i < size_; i++) {
+    sum[0] += data_[i] * other.data_[i];
+  }
+
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+void S21Vector::Axpy(double alpha, const S21Vector& x) {
+  if (size_ != x.size_) {
+    throw std::range_error("AxpyError: Vectors of different sizes");
+  }
+
+  for (int i = 0; i < size_; i++) {
+    data_[i] += alpha * x.data_[i];
+  }
+}
+
+void S21Vector::Scale(double alpha) {
+  for (int i = 0; i < size_; i++) {
+    data_[i] *= alpha;
+  }
+}
+
+double S21Vector::Norm() const {
+  double squares = Dot(*this);
+  // below this the small squares lose digits as subnormal numbers
+  double min_squares = std::numeric_limits<double>::min() /
+                       std::numeric_limits<double>::epsilon();
+  if (std::isfinite(squares) && squares >= min_squares) {
+    return std::sqrt(squares);
+  }
+
+  // the squares left the range of double, the scaled ones stay near 1
+  double max = 0;
+  for (int i = 0; i < size_; i++) {
+    double value = std::fabs(data_[i]);
+    // a NaN stays the maximum
+    if (value > max || std::isnan(value)) {
+      max = value;
+    }
+  }
+  if (max == 0 || !std::isfinite(max)) {
+    return max;
+  }
+  double scaled_squares = 0;
+  for (int i = 0; i < size_; i++) {
+    double scaled = data_[i] / max;
+    scaled_squares += scaled * scaled;
+  }
+  return max * std::sqrt(scaled_squares);
+}
+
+}  // namespace s_21
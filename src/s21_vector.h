@@ -0,0 +1,75 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+#ifndef CPP1_S21_MATRIXPLUS_SRC_S21_VECTOR_H_
+#define CPP1_S21_MATRIXPLUS_SRC_S21_VECTOR_H_
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace s_21 {
+class S21Matrix;
+
+class S21Vector {
+ public:
+  // Constructors
+
+  /**
+   * @throws CreationError: The size cannot be less than 1
+   */
+  explicit S21Vector(int size);
+  S21Vector(const S21Vector& other);
+  S21Vector(S21Vector&& other) noexcept;
+
+  // Assignment operators
+
+  S21Vector& operator=(const S21Vector& other);
+  S21Vector& operator=(S21Vector&& other) noexcept;
+
+  // Destructor
+
+  ~S21Vector();
+
+  // Getters
+
+  int GetSize() const;
+
+  // Overload operators
+
+  /**
+   * @throws InvalidIndexError: Index is out of range
+   */
+  double& operator()(int index);
+  /**
+   * @throws InvalidIndexError: Index is out of range
+   */
+  const double& operator()(int index) const;
+
+  // Member functions
+
+  /**
+   * @throws DotError: Vectors of different sizes
+   */
+  double Dot(const S21Vector& other) const;
+  /**
+   * this += alpha * x
+   * @throws AxpyError: Vectors of different sizes
+   */
+  void Axpy(double alpha, const S21Vector& x);
+  void Scale(double alpha);
+  // Euclidean norm, without overflow or underflow of the squares
+  double Norm() const;
+
+ private:
+  int size_;
+  double* data_;
+
+  // matrix-vector kernels work on the raw values
+  friend class S21Matrix;
+  friend class S21SymmetricMatrix;
+  friend class S21TriangularMatrix;
+  friend class S21BandMatrix;
+};
+}  // namespace s_21
+
+#endif  // CPP1_S21_MATRIXPLUS_SRC_S21_VECTOR_H_
@@ -4,12 +4,33 @@
 #define CPP1_S21_MATRIXPLUS_SRC_TESTS_UNIT_TEST_H_
 
 #include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <system_error>
+#include <thread>
 #include <vector>
 
+#include "../s21_band_matrix.h"
+#include "../s21_disk_matrix.h"
+#include "../s21_eigen.h"
+#include "../s21_incremental_inverse.h"
+#include "../s21_matrix_async.h"
+#include "../s21_matrix_cache.h"
+#include "../s21_matrix_chain.h"
 #include "../s21_matrix_oop.h"
+#include "../s21_shared_matrix.h"
+#include "../s21_symmetric_matrix.h"
+#include "../s21_trace.h"
+#include "../s21_triangular_matrix.h"
+#include "../s21_vector.h"
 
 namespace s_21 {
 
@@ -20,11 +41,14 @@ class S21MatrixTest : public testing::Test {
   S21Matrix *matrix_5x5;
   S21Matrix *matrix_12x21;
   S21Matrix *matrix_21x21;
+  std::uint64_t random_seed;
 
   void SetUp();
   void TearDown();
   void FillMatrixWithRandomDouble(S21Matrix &matrix);
   void PrintMatrix(const S21Matrix &matrix);
+  void ExpectNear(const S21Matrix &expected, const S21Matrix &actual,
+                  double abs_error);
 };
 
 }  // namespace s_21
@@ -2,6 +2,8 @@
 
 namespace s_21 {
 void S21MatrixTest::SetUp() {
+  random_seed = 21;
+
   matrix_1x1 = new S21Matrix(1, 1);
   (*matrix_1x1)(0, 0) = 12;
 
@@ -40,12 +42,12 @@ void S21MatrixTest::TearDown() {
 }
 
 void S21MatrixTest::FillMatrixWithRandomDouble(S21Matrix& matrix) {
-  srand(time(nullptr));
-  for (int i = 0; i < matrix.GetRows(); i++) {
-    for (int j = 0; j < matrix.GetCols(); j++) {
-      matrix(i, j) = rand() % 10;
-    }
-  }
+  // a new stream for every matrix, the same digits 0-9 on every run
+  S21Matrix random =
+      S21Matrix::Random(matrix.GetRows(), matrix.GetCols(),
+                        S21Matrix::Distribution::Uniform(0, 10), random_seed++);
+  std::transform(random.begin(), random.end(), matrix.begin(),
+                 [](double value) { return std::floor(value); });
 }
 
 void S21MatrixTest::PrintMatrix(const S21Matrix& matrix) {
@@ -63,6 +65,17 @@ void S21MatrixTest::PrintMatrix(const S21Matrix& matrix) {
             << "\n";
 }
 
+void S21MatrixTest::ExpectNear(const S21Matrix& expected,
+                               const S21Matrix& actual, double abs_error) {
+  ASSERT_EQ(expected.GetRows(), actual.GetRows());
+  ASSERT_EQ(expected.GetCols(), actual.GetCols());
+  for (int i = 0; i < expected.GetRows(); i++) {
+    for (int j = 0; j < expected.GetCols(); j++) {
+      EXPECT_NEAR(expected(i, j), actual(i, j), abs_error);
+    }
+  }
+}
+
 // UNIT TEST START
 
 // CONSTRUCTORS
@@ -129,6 +142,92 @@ TEST_F(S21MatrixTest, MoveConstructor2) {
   EXPECT_EQ(21, dst_matrix.GetCols());
 }
 
+// FACTORIES
+
+TEST_F(S21MatrixTest, IdentityAndFilled) {
+  S21Matrix identity = S21Matrix::Identity(3);
+  S21Matrix filled = S21Matrix::Filled(300, 301, 0.5);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_DOUBLE_EQ(i == j, identity(i, j));
+    }
+  }
+  EXPECT_EQ(300, filled.GetRows());
+  EXPECT_EQ(301, filled.GetCols());
+  EXPECT_DOUBLE_EQ(300 * 301 * 0.5, filled.Sum());
+  // large enough to be filled in chunks
+  S21Matrix large_identity = S21Matrix::Identity(300);
+  EXPECT_DOUBLE_EQ(300, large_identity.Sum());
+  EXPECT_DOUBLE_EQ(300, large_identity.Trace());
+  EXPECT_DOUBLE_EQ(1, large_identity.Norm1());
+  EXPECT_THROW(S21Matrix::Identity(0), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Filled(1, -1, 0), std::invalid_argument);
+}
+
+TEST_F(S21MatrixTest, Uninitialized) {
+  S21Matrix matrix = S21Matrix::Uninitialized(12, 21);
+  std::copy(matrix_12x21->begin(), matrix_12x21->end(), matrix.begin());
+  EXPECT_EQ(1, matrix == *matrix_12x21);
+  EXPECT_THROW(S21Matrix::Uninitialized(0, 1), std::invalid_argument);
+}
+
+TEST_F(S21MatrixTest, FromBuffer) {
+  double values[] = {1, 2, 3, -1, 4, 5, 6, -1};
+  S21Matrix copied = S21Matrix::FromBuffer(values, 2, 3, 4);
+  EXPECT_DOUBLE_EQ(3, copied(0, 2));
+  EXPECT_DOUBLE_EQ(4, copied(1, 0));
+  values[0] = 322;
+  EXPECT_DOUBLE_EQ(1, copied(0, 0));
+
+  std::unique_ptr<double[]> buffer(new double[6]{1, 2, 3, 4, 5, 6});
+  double* raw = buffer.get();
+  S21Matrix adopted = S21Matrix::FromBuffer(std::move(buffer), 3, 2);
+  EXPECT_EQ(raw, adopted.begin());
+  EXPECT_DOUBLE_EQ(6, adopted(2, 1));
+  adopted.SetCopyOnWrite(true);
+  S21Matrix copy(adopted);
+  copy(0, 0) = 322;
+  EXPECT_DOUBLE_EQ(1, adopted(0, 0));
+  double gram[] = {35, 44, 44, 56};
+  EXPECT_EQ(1, adopted.Transpose() * adopted ==
+                   S21Matrix::FromBuffer(gram, 2, 2, 2));
+
+  EXPECT_THROW(S21Matrix::FromBuffer(values, 2, 3, 2), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::FromBuffer(nullptr, 2, 3, 3), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::FromBuffer(std::unique_ptr<double[]>(), 2, 3),
+               std::invalid_argument);
+}
+
+TEST_F(S21MatrixTest, RandomIsReproducible) {
+  // large enough to be split between threads
+  S21Matrix uniform =
+      S21Matrix::Random(400, 300, S21Matrix::Distribution::Uniform(-2, 3), 7);
+  EXPECT_EQ(1, uniform == S21Matrix::Random(
+                              400, 300,
+                              S21Matrix::Distribution::Uniform(-2, 3), 7));
+  EXPECT_FALSE(uniform == S21Matrix::Random(
+                              400, 300,
+                              S21Matrix::Distribution::Uniform(-2, 3), 8));
+  double min = *std::min_element(uniform.begin(), uniform.end());
+  double max = *std::max_element(uniform.begin(), uniform.end());
+  EXPECT_GE(min, -2);
+  EXPECT_LT(max, 3);
+  EXPECT_NEAR(0.5, uniform.Sum() / (400 * 300), 0.02);
+
+  // value (i, j) depends on i * cols + j only
+  S21Matrix row = S21Matrix::Random(1, 400 * 300,
+                                    S21Matrix::Distribution::Uniform(-2, 3), 7);
+  EXPECT_DOUBLE_EQ(uniform(399, 299), row(0, 400 * 300 - 1));
+
+  S21Matrix normal =
+      S21Matrix::Random(400, 300, S21Matrix::Distribution::Normal(1, 2), 7);
+  double mean = normal.Sum() / (400 * 300);
+  double frobenius = normal.NormFrobenius();
+  double variance = frobenius * frobenius / (400 * 300) - mean * mean;
+  EXPECT_NEAR(1, mean, 0.03);
+  EXPECT_NEAR(4, variance, 0.1);
+}
+
 // ASSIGNMENT OPERATORS
 
 TEST_F(S21MatrixTest, AssignmentOperator) {
@@ -322,12 +421,35 @@ TEST_F(S21MatrixTest, NumMulOperator) {
   EXPECT_DOUBLE_EQ(-15.7, matrix(1, 0));
   EXPECT_DOUBLE_EQ(12.56, matrix(1, 1));
   EXPECT_DOUBLE_EQ(12.56, matrix(1, 2));
+
+  const S21Matrix& source = *matrix_2x3;
+  EXPECT_EQ(1, 2.0 * source == source * 2.0);
 }
 
 TEST_F(S21MatrixTest, EqOperator) {
   EXPECT_EQ(1, (*matrix_21x21) == (*matrix_21x21));
 }
 
+TEST_F(S21MatrixTest, EqMatrixComparesAllValues) {
+  S21Matrix matrix(*matrix_21x21);
+  matrix(20, 20) += 1;
+  EXPECT_FALSE(matrix.EqMatrix(*matrix_21x21));
+  matrix(20, 20) -= 1 - 1e-9;
+  EXPECT_TRUE(matrix.EqMatrix(*matrix_21x21));
+  EXPECT_FALSE(matrix_2x3->EqMatrix(matrix_2x3->Transpose()));
+}
+
+TEST_F(S21MatrixTest, EqMatrixNonFinite) {
+  S21Matrix matrix(*matrix_2x3);
+  matrix(1, 1) = std::nan("");
+  EXPECT_FALSE(matrix.EqMatrix(*matrix_2x3));
+  EXPECT_FALSE(matrix_2x3->EqMatrix(matrix));
+  EXPECT_FALSE(matrix.EqMatrix(matrix));
+  matrix(1, 1) = INFINITY;
+  EXPECT_FALSE(matrix.EqMatrix(*matrix_2x3));
+  EXPECT_TRUE(matrix.EqMatrix(matrix));
+}
+
 TEST_F(S21MatrixTest, ParenthesesOperator) {
   S21Matrix matrix;
   matrix(3, 2) = 322;
@@ -339,6 +461,69 @@ TEST_F(S21MatrixTest, ParenthesesOperatorException) {
   EXPECT_THROW(matrix(-4, 6), std::out_of_range);
 }
 
+// FAST ACCESS
+
+TEST_F(S21MatrixTest, AtMatchesParenthesesOperator) {
+  const S21Matrix& matrix = *matrix_12x21;
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) {
+      EXPECT_EQ(&matrix(i, j), &matrix.At(i, j));
+    }
+  }
+  matrix_2x3->At(1, 2) = 322;
+  EXPECT_DOUBLE_EQ(322, (*matrix_2x3)(1, 2));
+}
+
+TEST_F(S21MatrixTest, RowSpan) {
+  S21Span<double> row = matrix_2x3->Row(1);
+  EXPECT_EQ(3, row.size());
+  EXPECT_DOUBLE_EQ(-5.0, row[0]);
+  for (double& value : row) {
+    value = 1;
+  }
+  EXPECT_DOUBLE_EQ(1, (*matrix_2x3)(1, 2));
+
+  const S21Matrix& matrix = *matrix_2x3;
+  S21Span<const double> const_row = matrix.Row(0);
+  EXPECT_EQ(&matrix(0, 0), const_row.data());
+  EXPECT_THROW(matrix_2x3->Row(2), std::out_of_range);
+  EXPECT_THROW(matrix.Row(-1), std::out_of_range);
+}
+
+TEST_F(S21MatrixTest, BeginEndCoverAllValues) {
+  const S21Matrix& matrix = *matrix_12x21;
+  EXPECT_EQ(12 * 21, matrix.end() - matrix.begin());
+  double sum = 0;
+  for (double value : matrix) {
+    sum += value;
+  }
+  double expected = 0;
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) {
+      expected += matrix(i, j);
+    }
+  }
+  EXPECT_DOUBLE_EQ(expected, sum);
+  EXPECT_EQ(&matrix(11, 20), matrix.end() - 1);
+}
+
+TEST_F(S21MatrixTest, FastAccessDetachesSharedStorage) {
+  matrix_2x3->SetCopyOnWrite(true);
+  S21Matrix at(*matrix_2x3);
+  S21Matrix row(*matrix_2x3);
+  S21Matrix iterated(*matrix_2x3);
+  at.At(0, 0) = 1;
+  row.Row(0)[0] = 2;
+  for (double& value : iterated) {
+    value = 3;
+  }
+  EXPECT_FALSE(matrix_2x3->IsShared());
+  EXPECT_DOUBLE_EQ(-5.0, (*matrix_2x3)(0, 0));
+  EXPECT_DOUBLE_EQ(1, at(0, 0));
+  EXPECT_DOUBLE_EQ(2, row(0, 0));
+  EXPECT_DOUBLE_EQ(3, iterated(1, 2));
+}
+
 // MEMBER FUNCTIONS
 
 TEST_F(S21MatrixTest, Transpose1) {
@@ -412,6 +597,1132 @@ TEST_F(S21MatrixTest, InverseMatrixException) {
   EXPECT_THROW((*matrix_12x21).InverseMatrix(), std::range_error);
 }
 
+// REDUCTIONS
+
+TEST_F(S21MatrixTest, Reductions) {
+  const S21Matrix& matrix = *matrix_2x3;
+  EXPECT_DOUBLE_EQ(1, matrix.Sum());
+  EXPECT_DOUBLE_EQ(5, matrix.MaxAbs());
+  EXPECT_DOUBLE_EQ(10, matrix.Norm1());
+  EXPECT_DOUBLE_EQ(13, matrix.NormInf());
+  EXPECT_DOUBLE_EQ(std::sqrt(91), matrix.NormFrobenius());
+  S21Vector row_sums = matrix.RowSums();
+  EXPECT_DOUBLE_EQ(-2, row_sums(0));
+  EXPECT_DOUBLE_EQ(3, row_sums(1));
+  S21Vector col_sums = matrix.ColSums();
+  EXPECT_DOUBLE_EQ(-10, col_sums(0));
+  EXPECT_DOUBLE_EQ(4, col_sums(1));
+  EXPECT_DOUBLE_EQ(7, col_sums(2));
+  EXPECT_DOUBLE_EQ(1992, matrix_5x5->Trace());
+  EXPECT_THROW(matrix.Trace(), std::range_error);
+}
+
+TEST_F(S21MatrixTest, ReductionsAreCompensated) {
+  S21Matrix matrix(1, 3);
+  matrix(0, 0) = 1e16;
+  matrix(0, 1) = 1;
+  matrix(0, 2) = -1e16;
+  EXPECT_DOUBLE_EQ(1, matrix.Sum());
+  EXPECT_DOUBLE_EQ(1, matrix.RowSums()(0));
+  EXPECT_DOUBLE_EQ(1, matrix.Transpose().ColSums()(0));
+  EXPECT_DOUBLE_EQ(1, matrix.Transpose().Sum());
+
+  S21Matrix huge(2, 2);
+  for (double& value : huge) {
+    value = 1e200;
+  }
+  EXPECT_DOUBLE_EQ(2e200, huge.NormFrobenius());
+  S21Matrix tiny = huge * 1e-200 * 1e-200;
+  EXPECT_DOUBLE_EQ(2e-200, tiny.NormFrobenius());
+
+  S21Matrix with_nan(*matrix_2x3);
+  with_nan(1, 1) = std::nan("");
+  EXPECT_TRUE(std::isnan(with_nan.MaxAbs()));
+  EXPECT_TRUE(std::isnan(with_nan.Norm1()));
+  EXPECT_TRUE(std::isnan(with_nan.NormInf()));
+  EXPECT_TRUE(std::isnan(with_nan.NormFrobenius()));
+}
+
+TEST_F(S21MatrixTest, ReductionsReachInfinity) {
+  // wide enough for the vector lanes as well as the scalar rest
+  S21Matrix with_inf = S21Matrix::Filled(3, 19, 1);
+  with_inf(1, 1) = INFINITY;
+  with_inf(2, 17) = INFINITY;
+  EXPECT_EQ(INFINITY, with_inf.Sum());
+  EXPECT_EQ(INFINITY, with_inf.Norm1());
+  EXPECT_EQ(INFINITY, with_inf.NormInf());
+  EXPECT_EQ(INFINITY, with_inf.RowSums()(1));
+  EXPECT_EQ(19, with_inf.RowSums()(0));
+  EXPECT_EQ(INFINITY, with_inf.ColSums()(17));
+  EXPECT_EQ(3, with_inf.ColSums()(0));
+  EXPECT_EQ(INFINITY, with_inf.Transpose().ColSums()(1));
+  S21Matrix square(*matrix_5x5);
+  square(2, 2) = -INFINITY;
+  EXPECT_EQ(-INFINITY, square.Trace());
+
+  S21Matrix overflow = S21Matrix::Filled(2, 19, 1e308);
+  EXPECT_EQ(INFINITY, overflow.Sum());
+  EXPECT_EQ(INFINITY, overflow.Norm1());
+  EXPECT_EQ(INFINITY, overflow.NormInf());
+  EXPECT_EQ(INFINITY, overflow.RowSums()(0));
+  EXPECT_EQ(INFINITY, overflow.ColSums()(0));
+  EXPECT_EQ(INFINITY, overflow.Transpose().ColSums()(1));
+  S21Matrix diagonal(2, 2);
+  diagonal(0, 0) = diagonal(1, 1) = 1e308;
+  EXPECT_EQ(INFINITY, diagonal.Trace());
+}
+
+TEST_F(S21MatrixTest, ReductionsLarge) {
+  // large enough to be split between threads
+  S21Matrix matrix(600, 400);
+  double expected = 0;
+  for (int i = 0; i < 600; i++) {
+    for (int j = 0; j < 400; j++) {
+      matrix(i, j) = (i * 400 + j) % 7 - 3.25;
+      expected += matrix(i, j);
+    }
+  }
+
+  double sum = matrix.Sum();
+  EXPECT_NEAR(expected, sum, 1e-9);
+  EXPECT_EQ(sum, matrix.Sum());
+  S21Vector row_sums = matrix.RowSums();
+  S21Vector col_sums = matrix.ColSums();
+  double rows_total = 0, cols_total = 0;
+  for (int i = 0; i < 600; i++) {
+    rows_total += row_sums(i);
+  }
+  for (int j = 0; j < 400; j++) {
+    cols_total += col_sums(j);
+  }
+  EXPECT_NEAR(expected, rows_total, 1e-9);
+  EXPECT_NEAR(expected, cols_total, 1e-9);
+  EXPECT_DOUBLE_EQ(3.25, matrix.MaxAbs());
+  EXPECT_DOUBLE_EQ(matrix.Transpose().Norm1(), matrix.NormInf());
+}
+
+// COPY-ON-WRITE
+
+TEST_F(S21MatrixTest, CopyOnWriteDisabledByDefault) {
+  S21Matrix matrix(*matrix_5x5);
+  EXPECT_FALSE(matrix_5x5->IsCopyOnWrite());
+  EXPECT_FALSE(matrix.IsShared());
+  EXPECT_FALSE(matrix_5x5->IsShared());
+}
+
+TEST_F(S21MatrixTest, CopyOnWriteSharesStorage) {
+  matrix_5x5->SetCopyOnWrite(true);
+  S21Matrix matrix(*matrix_5x5);
+  S21Matrix assigned;
+  assigned = *matrix_5x5;
+  EXPECT_TRUE(matrix.IsCopyOnWrite());
+  EXPECT_TRUE(matrix.IsShared());
+  EXPECT_TRUE(assigned.IsShared());
+  EXPECT_EQ(1, matrix == *matrix_5x5);
+  EXPECT_EQ(1, assigned == *matrix_5x5);
+}
+
+TEST_F(S21MatrixTest, CopyOnWriteDetachesOnAccess) {
+  matrix_5x5->SetCopyOnWrite(true);
+  S21Matrix matrix(*matrix_5x5);
+  matrix(0, 0) = 322;
+  EXPECT_FALSE(matrix.IsShared());
+  EXPECT_FALSE(matrix_5x5->IsShared());
+  EXPECT_DOUBLE_EQ(322, matrix(0, 0));
+  EXPECT_DOUBLE_EQ(-5.0, (*matrix_5x5)(0, 0));
+}
+
+TEST_F(S21MatrixTest, CopyOnWriteDetachesOnOperations) {
+  matrix_2x3->SetCopyOnWrite(true);
+  S21Matrix sum(*matrix_2x3);
+  S21Matrix product(*matrix_2x3);
+  sum += *matrix_2x3;
+  product *= 2;
+  EXPECT_FALSE(matrix_2x3->IsShared());
+  EXPECT_EQ(1, sum == product);
+  EXPECT_DOUBLE_EQ(-10.0, sum(0, 0));
+  EXPECT_DOUBLE_EQ(-5.0, (*matrix_2x3)(0, 0));
+}
+
+TEST_F(S21MatrixTest, CopyOnWriteReferenceMakesCopiesDeep) {
+  matrix_5x5->SetCopyOnWrite(true);
+  double& value = (*matrix_5x5)(1, 1);
+  S21Matrix copy(*matrix_5x5);
+  S21Matrix assigned;
+  assigned = *matrix_5x5;
+  EXPECT_FALSE(copy.IsShared());
+  EXPECT_FALSE(assigned.IsShared());
+  value = 322;
+  EXPECT_DOUBLE_EQ(322, (*matrix_5x5)(1, 1));
+  EXPECT_DOUBLE_EQ(0, copy(1, 1));
+  EXPECT_DOUBLE_EQ(0, assigned(1, 1));
+
+  S21Matrix source(*matrix_2x3);
+  source.SetCopyOnWrite(true);
+  double* values = source.begin();
+  S21Span<double> row = source.Row(1);
+  S21Matrix from_begin(source);
+  values[0] = 1;
+  row[0] = 2;
+  EXPECT_DOUBLE_EQ(-5, from_begin(0, 0));
+  EXPECT_DOUBLE_EQ(2, source(1, 0));
+  // a resized matrix gets fresh storage that can be shared again
+  source.SetRows(3);
+  S21Matrix shared(source);
+  EXPECT_TRUE(shared.IsShared());
+}
+
+TEST_F(S21MatrixTest, CopyOnWriteDetach) {
+  matrix_21x21->SetCopyOnWrite(true);
+  S21Matrix matrix(*matrix_21x21);
+  matrix.Detach();
+  EXPECT_FALSE(matrix.IsShared());
+  EXPECT_TRUE(matrix.IsCopyOnWrite());
+  EXPECT_EQ(1, matrix == *matrix_21x21);
+}
+
+TEST_F(S21MatrixTest, CopyOnWriteDisable) {
+  matrix_1x1->SetCopyOnWrite(true);
+  S21Matrix matrix(*matrix_1x1);
+  matrix.SetCopyOnWrite(false);
+  S21Matrix copy(matrix);
+  EXPECT_FALSE(matrix.IsShared());
+  EXPECT_FALSE(copy.IsShared());
+  EXPECT_DOUBLE_EQ(12, copy(0, 0));
+}
+
+TEST_F(S21MatrixTest, Solve) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2, matrix(0, 1) = 5, matrix(0, 2) = 7;
+  matrix(1, 0) = 6, matrix(1, 1) = 3, matrix(1, 2) = 4;
+  matrix(2, 0) = 5, matrix(2, 1) = -2, matrix(2, 2) = -3;
+  S21Matrix b(3, 1);
+  b(0, 0) = 1, b(1, 0) = 2, b(2, 0) = 3;
+  S21Matrix x = matrix.Solve(b);
+  EXPECT_NEAR(2, x(0, 0), 1e-9);
+  EXPECT_NEAR(-58, x(1, 0), 1e-9);
+  EXPECT_NEAR(41, x(2, 0), 1e-9);
+}
+
+TEST_F(S21MatrixTest, SolveException) {
+  S21Matrix singular(2, 2);
+  S21Matrix b(2, 1);
+  EXPECT_THROW(singular.Solve(b), std::range_error);
+  EXPECT_THROW((*matrix_5x5).Solve(b), std::range_error);
+  EXPECT_THROW((*matrix_2x3).Solve(b), std::range_error);
+}
+
+TEST_F(S21MatrixTest, Pow) {
+  S21Matrix reference_matrix(*matrix_5x5);
+  for (int i = 1; i < 7; i++) {
+    reference_matrix *= (*matrix_5x5);
+  }
+  S21Matrix power = (*matrix_5x5).Pow(7);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      EXPECT_NEAR(reference_matrix(i, j), power(i, j),
+                  std::fabs(reference_matrix(i, j)) * 1e-12);
+    }
+  }
+}
+
+TEST_F(S21MatrixTest, PowZeroAndNegative) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = 1, matrix(0, 1) = 1;
+  matrix(1, 0) = 0, matrix(1, 1) = 1;
+  S21Matrix identity = matrix.Pow(0);
+  EXPECT_DOUBLE_EQ(1, identity(0, 0));
+  EXPECT_DOUBLE_EQ(0, identity(0, 1));
+  EXPECT_DOUBLE_EQ(1, identity(1, 1));
+  S21Matrix power = matrix.Pow(-1000000);
+  EXPECT_NEAR(1, power(0, 0), 1e-9);
+  EXPECT_NEAR(-1000000, power(0, 1), 1e-6);
+  EXPECT_NEAR(0, power(1, 0), 1e-9);
+  EXPECT_NEAR(1, power(1, 1), 1e-9);
+}
+
+TEST_F(S21MatrixTest, PowException) {
+  EXPECT_THROW((*matrix_2x3).Pow(2), std::range_error);
+}
+
+TEST_F(S21MatrixTest, Exp) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 1, matrix(1, 1) = -2, matrix(2, 2) = 5;
+  S21Matrix exponent = matrix.Exp();
+  EXPECT_NEAR(std::exp(1), exponent(0, 0), 1e-12);
+  EXPECT_NEAR(std::exp(-2), exponent(1, 1), 1e-12);
+  EXPECT_NEAR(std::exp(5), exponent(2, 2), std::exp(5) * 1e-12);
+  EXPECT_NEAR(0, exponent(0, 1), 1e-12);
+}
+
+TEST_F(S21MatrixTest, ExpRotation) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 1) = -M_PI / 3, matrix(1, 0) = M_PI / 3;
+  S21Matrix exponent = matrix.Exp();
+  EXPECT_NEAR(0.5, exponent(0, 0), 1e-12);
+  EXPECT_NEAR(-std::sqrt(3) / 2, exponent(0, 1), 1e-12);
+  EXPECT_NEAR(std::sqrt(3) / 2, exponent(1, 0), 1e-12);
+  EXPECT_NEAR(0.5, exponent(1, 1), 1e-12);
+}
+
+TEST_F(S21MatrixTest, ExpException) {
+  EXPECT_THROW((*matrix_12x21).Exp(), std::range_error);
+  S21Matrix matrix(2, 2);
+  matrix(0, 1) = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(matrix.Exp(), std::range_error);
+  matrix(0, 1) = std::nan("");
+  EXPECT_THROW(matrix.Exp(), std::range_error);
+}
+
+// VECTOR
+
+TEST_F(S21MatrixTest, VectorConstructor) {
+  S21Vector vector(7);
+  EXPECT_EQ(7, vector.GetSize());
+  EXPECT_EQ(0, vector(6));
+  EXPECT_THROW(S21Vector empty(0), std::invalid_argument);
+  EXPECT_THROW(vector(7), std::out_of_range);
+}
+
+TEST_F(S21MatrixTest, VectorCopyAndMove) {
+  S21Vector vector(3);
+  vector(1) = 21;
+  S21Vector copy(vector);
+  copy(1) = 12;
+  S21Vector moved(std::move(vector));
+  EXPECT_EQ(0, vector.GetSize());
+  EXPECT_EQ(21, moved(1));
+  EXPECT_EQ(12, copy(1));
+}
+
+TEST_F(S21MatrixTest, VectorDotAxpyNorm) {
+  S21Vector x(5);
+  S21Vector y(5);
+  for (int i = 0; i < 5; i++) {
+    x(i) = i + 1;
+    y(i) = 2;
+  }
+  EXPECT_DOUBLE_EQ(30, x.Dot(y));
+  y.Axpy(-2, x);
+  EXPECT_DOUBLE_EQ(-8, y(4));
+  EXPECT_DOUBLE_EQ(std::sqrt(55), x.Norm());
+  S21Vector huge(2), tiny(2);
+  huge(0) = huge(1) = 1e200;
+  tiny(0) = tiny(1) = 1e-200;
+  EXPECT_DOUBLE_EQ(std::sqrt(2) * 1e200, huge.Norm());
+  EXPECT_DOUBLE_EQ(std::sqrt(2) * 1e-200, tiny.Norm());
+  huge(1) = INFINITY;
+  EXPECT_EQ(INFINITY, huge.Norm());
+  tiny(0) = std::nan("");
+  EXPECT_TRUE(std::isnan(tiny.Norm()));
+  x.Scale(0.5);
+  EXPECT_DOUBLE_EQ(2.5, x(4));
+  S21Vector z(4);
+  EXPECT_THROW(x.Dot(z), std::range_error);
+  EXPECT_THROW(x.Axpy(1, z), std::range_error);
+}
+
+TEST_F(S21MatrixTest, Gemv) {
+  S21Vector x(21);
+  S21Matrix x_matrix(21, 1);
+  for (int i = 0; i < 21; i++) {
+    x(i) = x_matrix(i, 0) = i - 10;
+  }
+  S21Vector y(12);
+  y(3) = 1;
+  (*matrix_12x21).Gemv(2, x, -1, y);
+  S21Matrix reference_matrix = (*matrix_12x21) * x_matrix;
+  for (int i = 0; i < 12; i++) {
+    EXPECT_DOUBLE_EQ(2 * reference_matrix(i, 0) - (i == 3), y(i));
+  }
+  S21Vector product = (*matrix_12x21) * x;
+  EXPECT_DOUBLE_EQ(reference_matrix(7, 0), product(7));
+}
+
+TEST_F(S21MatrixTest, Gevm) {
+  S21Vector x(12);
+  for (int i = 0; i < 12; i++) {
+    x(i) = 0.5 * i;
+  }
+  S21Vector y(21);
+  (*matrix_12x21).Gevm(1, x, 0, y);
+  S21Vector reference = (*matrix_12x21).Transpose() * x;
+  for (int j = 0; j < 21; j++) {
+    EXPECT_DOUBLE_EQ(reference(j), y(j));
+  }
+}
+
+TEST_F(S21MatrixTest, GemvParallel) {
+  const int size = 700;
+  S21Matrix matrix(size, size);
+  S21Vector x(size);
+  for (int i = 0; i < size; i++) {
+    x(i) = 1.0 / (i + 1);
+    for (int j = 0; j < size; j++) {
+      matrix(i, j) = (i * 31 + j * 17) % 13 - 6;
+    }
+  }
+  S21Vector y = matrix * x;
+  S21Vector y_transposed(size);
+  matrix.Transpose().Gevm(1, x, 0, y_transposed);
+  for (int i = 0; i < size; i += 7) {
+    double expected = 0;
+    for (int j = 0; j < size; j++) {
+      expected += matrix(i, j) * x(j);
+    }
+    EXPECT_NEAR(expected, y(i), 1e-9);
+    EXPECT_NEAR(expected, y_transposed(i), 1e-9);
+  }
+
+  // tall, the column chunks do not get narrower than a cache line allows
+  S21Matrix tall = S21Matrix::Random(
+      3000, 100, S21Matrix::Distribution::Uniform(-1, 1), 21);
+  S21Vector ones(3000), col_sums(100);
+  for (int i = 0; i < 3000; i++) {
+    ones(i) = 1;
+  }
+  tall.Gevm(1, ones, 0, col_sums);
+  S21Vector expected_sums = tall.ColSums();
+  for (int j = 0; j < 100; j++) {
+    EXPECT_NEAR(expected_sums(j), col_sums(j), 1e-9);
+  }
+}
+
+TEST_F(S21MatrixTest, GemvException) {
+  S21Vector x(5);
+  S21Vector y(5);
+  EXPECT_THROW((*matrix_2x3).Gemv(1, x, 0, y), std::range_error);
+  EXPECT_THROW((*matrix_2x3).Gevm(1, x, 0, y), std::range_error);
+}
+
+// STRUCTURED MATRICES
+
+TEST_F(S21MatrixTest, SymmetricMatrix) {
+  S21SymmetricMatrix symmetric(3);
+  symmetric(0, 1) = 2;
+  symmetric(2, 2) = 5;
+  EXPECT_EQ(2, symmetric(1, 0));
+  S21Matrix matrix = symmetric.ToMatrix();
+  EXPECT_EQ(2, matrix(0, 1));
+  EXPECT_EQ(2, matrix(1, 0));
+  S21SymmetricMatrix converted(matrix);
+  EXPECT_EQ(1, converted.ToMatrix() == matrix);
+  EXPECT_THROW(symmetric(3, 0), std::out_of_range);
+  EXPECT_THROW(S21SymmetricMatrix wrong(*matrix_2x3), std::range_error);
+}
+
+TEST_F(S21MatrixTest, SymmetricMatrixProducts) {
+  S21Matrix matrix = (*matrix_21x21) + (*matrix_21x21).Transpose();
+  S21SymmetricMatrix symmetric(matrix);
+  S21Matrix product = symmetric.MulMatrix(*matrix_21x21);
+  S21Matrix reference_matrix = matrix * (*matrix_21x21);
+  S21Vector x(21);
+  for (int i = 0; i < 21; i++) {
+    x(i) = i % 4 - 1.5;
+  }
+  S21Vector y(21);
+  symmetric.Gemv(1, x, 0, y);
+  S21Vector reference = matrix * x;
+  for (int i = 0; i < 21; i++) {
+    EXPECT_DOUBLE_EQ(reference(i), y(i));
+    for (int j = 0; j < 21; j++) {
+      EXPECT_DOUBLE_EQ(reference_matrix(i, j), product(i, j));
+    }
+  }
+}
+
+TEST_F(S21MatrixTest, TriangularMatrix) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2, matrix(0, 1) = 5, matrix(0, 2) = 7;
+  matrix(1, 0) = 6, matrix(1, 1) = 3, matrix(1, 2) = 4;
+  matrix(2, 0) = 5, matrix(2, 1) = -2, matrix(2, 2) = -3;
+  S21TriangularMatrix upper(matrix, S21TriangularMatrix::Triangle::kUpper);
+  S21TriangularMatrix lower(matrix, S21TriangularMatrix::Triangle::kLower);
+  EXPECT_EQ(4, upper(1, 2));
+  EXPECT_EQ(6, lower(1, 0));
+  EXPECT_THROW(upper(1, 0) = 1, std::out_of_range);
+  const S21TriangularMatrix& const_upper = upper;
+  EXPECT_EQ(0, const_upper(1, 0));
+  EXPECT_DOUBLE_EQ(-18, upper.Determinant());
+  EXPECT_DOUBLE_EQ(-18, lower.Determinant());
+  S21Matrix full = lower.ToMatrix();
+  EXPECT_EQ(0, full(0, 2));
+  EXPECT_EQ(-2, full(2, 1));
+}
+
+TEST_F(S21MatrixTest, TriangularMatrixSolve) {
+  S21TriangularMatrix upper(*matrix_21x21,
+                            S21TriangularMatrix::Triangle::kUpper);
+  S21TriangularMatrix lower(*matrix_21x21,
+                            S21TriangularMatrix::Triangle::kLower);
+  for (int i = 0; i < 21; i++) {
+    upper(i, i) = lower(i, i) = 10 + i;
+  }
+  S21Matrix b = (*matrix_12x21).Transpose();
+  S21Matrix x_upper = upper.Solve(b);
+  S21Matrix check = upper.ToMatrix() * x_upper;
+  S21Matrix x_lower = lower.Solve(b);
+  S21Matrix check_lower = lower.ToMatrix() * x_lower;
+  for (int i = 0; i < 21; i++) {
+    for (int j = 0; j < 12; j++) {
+      EXPECT_NEAR(b(i, j), check(i, j), 1e-9);
+      EXPECT_NEAR(b(i, j), check_lower(i, j), 1e-9);
+    }
+  }
+  S21TriangularMatrix singular(3, S21TriangularMatrix::Triangle::kLower);
+  EXPECT_THROW(singular.Solve(S21Matrix(3, 1)), std::range_error);
+}
+
+TEST_F(S21MatrixTest, BandMatrix) {
+  S21BandMatrix band(5, 1, 2);
+  band(0, 2) = 3;
+  band(4, 3) = -1;
+  const S21BandMatrix& const_band = band;
+  EXPECT_EQ(0, const_band(4, 0));
+  EXPECT_THROW(band(4, 0) = 1, std::out_of_range);
+  EXPECT_THROW(S21BandMatrix wrong(5, -1, 0), std::invalid_argument);
+  S21Matrix matrix = band.ToMatrix();
+  EXPECT_EQ(3, matrix(0, 2));
+  EXPECT_EQ(-1, matrix(4, 3));
+  const S21BandMatrix converted(*matrix_5x5, 1, 1);
+  EXPECT_EQ(0, converted(0, 2));
+  EXPECT_EQ(21, converted(1, 2));
+}
+
+TEST_F(S21MatrixTest, BandMatrixSolve) {
+  const int size = 40;
+  S21BandMatrix band(size, 2, 1);
+  for (int i = 0; i < size; i++) {
+    for (int j = std::max(0, i - 2); j <= std::min(size - 1, i + 1); j++) {
+      // the subdiagonal dominates, so the rows have to be swapped
+      band(i, j) = i == j + 1 ? 4 : (i + j) % 3 + 1;
+    }
+  }
+  S21Matrix matrix = band.ToMatrix();
+  S21Matrix b(size, 2);
+  S21Vector x(size);
+  for (int i = 0; i < size; i++) {
+    b(i, 0) = i;
+    b(i, 1) = 1;
+    x(i) = i * 0.25;
+  }
+  S21Matrix solution = band.Solve(b);
+  S21Matrix check = matrix * solution;
+  for (int i = 0; i < size; i++) {
+    EXPECT_NEAR(b(i, 0), check(i, 0), 1e-9);
+    EXPECT_NEAR(b(i, 1), check(i, 1), 1e-9);
+  }
+  S21Vector y(size);
+  band.Gemv(1, x, 0, y);
+  S21Vector reference = matrix * x;
+  for (int i = 0; i < size; i++) {
+    EXPECT_DOUBLE_EQ(reference(i), y(i));
+  }
+  S21Matrix small(3, 3);
+  small(0, 0) = 2, small(0, 1) = 5, small(0, 2) = 7;
+  small(1, 0) = 6, small(1, 1) = 3, small(1, 2) = 4;
+  small(2, 0) = 5, small(2, 1) = -2, small(2, 2) = -3;
+  EXPECT_NEAR(-1, S21BandMatrix(small, 2, 2).Determinant(), 1e-12);
+  S21BandMatrix tridiagonal(6, 1, 1);
+  for (int i = 0; i < 6; i++) {
+    tridiagonal(i, i) = i % 2 ? 0 : 3;
+    if (i > 0) {
+      tridiagonal(i, i - 1) = i;
+      tridiagonal(i - 1, i) = -2;
+    }
+  }
+  EXPECT_NEAR(tridiagonal.ToMatrix().Determinant(), tridiagonal.Determinant(),
+              1e-9);
+}
+
+// INCREMENTAL INVERSE
+
+TEST_F(S21MatrixTest, IncrementalInverseRankOneUpdate) {
+  S21Matrix matrix = (*matrix_21x21) + (*matrix_21x21).Transpose();
+  for (int i = 0; i < 21; i++) {
+    matrix(i, i) += 100;
+  }
+  S21IncrementalInverse incremental(matrix);
+  S21Vector u(21);
+  S21Vector v(21);
+  for (int i = 0; i < 21; i++) {
+    u(i) = i % 3;
+    v(i) = 0.5 - i % 2;
+  }
+  incremental.RankOneUpdate(u, v);
+  for (int i = 0; i < 21; i++) {
+    for (int j = 0; j < 21; j++) {
+      matrix(i, j) += u(i) * v(j);
+    }
+  }
+  ExpectNear(matrix, incremental.GetMatrix(), 1e-12);
+  ExpectNear(matrix.Solve(S21Matrix(21, 21).Pow(0)), incremental.GetInverse(),
+             1e-12);
+  S21IncrementalInverse fresh(matrix);
+  EXPECT_NEAR(1, incremental.GetDeterminant() / fresh.GetDeterminant(),
+              1e-10);
+}
+
+TEST_F(S21MatrixTest, IncrementalInverseReplace) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2, matrix(0, 1) = 5, matrix(0, 2) = 7;
+  matrix(1, 0) = 6, matrix(1, 1) = 3, matrix(1, 2) = 4;
+  matrix(2, 0) = 5, matrix(2, 1) = -2, matrix(2, 2) = -3;
+  S21IncrementalInverse incremental(matrix);
+  EXPECT_NEAR(-1, incremental.GetDeterminant(), 1e-12);
+  S21Vector values(3);
+  values(0) = 1, values(1) = 0, values(2) = 2;
+  incremental.ReplaceRow(1, values);
+  incremental.ReplaceCol(2, values);
+  matrix(1, 0) = 1, matrix(1, 1) = 0;
+  matrix(0, 2) = 1, matrix(1, 2) = 0, matrix(2, 2) = 2;
+  EXPECT_EQ(1, incremental.GetMatrix() == matrix);
+  EXPECT_NEAR(matrix.Determinant(), incremental.GetDeterminant(), 1e-12);
+  ExpectNear(matrix.InverseMatrix(), incremental.GetInverse(), 1e-12);
+}
+
+TEST_F(S21MatrixTest, IncrementalInverseReplaceExactly) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = 1, matrix(1, 1) = 1;
+  S21IncrementalInverse incremental(matrix);
+  // 1 + (1e-17 - 1) rounds to the singular 0, the new value itself is not
+  S21Vector values(2);
+  values(0) = 1, values(1) = 1e-17;
+  incremental.ReplaceRow(1, values);
+  matrix(1, 0) = 1, matrix(1, 1) = 1e-17;
+  EXPECT_DOUBLE_EQ(1e-17, incremental.GetMatrix()(1, 1));
+  EXPECT_DOUBLE_EQ(1e-17, incremental.GetDeterminant());
+
+  // every update refactorizes, a singular result leaves everything as it was
+  S21IncrementalInverse periodic(matrix, 1);
+  S21Vector zeros(2);
+  EXPECT_THROW(periodic.ReplaceCol(0, zeros), std::range_error);
+  EXPECT_EQ(1, periodic.GetMatrix() == matrix);
+  EXPECT_DOUBLE_EQ(1e-17, periodic.GetDeterminant());
+  values(0) = 3, values(1) = 1;
+  periodic.ReplaceCol(0, values);
+  matrix(0, 0) = 3, matrix(1, 0) = 1;
+  EXPECT_EQ(1, periodic.GetMatrix() == matrix);
+  EXPECT_DOUBLE_EQ(3e-17, periodic.GetDeterminant());
+}
+
+TEST_F(S21MatrixTest, IncrementalInverseAppend) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = 4, matrix(0, 1) = 1;
+  matrix(1, 0) = 2, matrix(1, 1) = 3;
+  S21IncrementalInverse incremental(matrix);
+  S21Vector row(2);
+  S21Vector col(2);
+  row(0) = 1, row(1) = -1;
+  col(0) = 0, col(1) = 5;
+  incremental.AppendRowCol(row, col, 2);
+  S21Matrix bordered(3, 3);
+  bordered(0, 0) = 4, bordered(0, 1) = 1, bordered(0, 2) = 0;
+  bordered(1, 0) = 2, bordered(1, 1) = 3, bordered(1, 2) = 5;
+  bordered(2, 0) = 1, bordered(2, 1) = -1, bordered(2, 2) = 2;
+  EXPECT_EQ(3, incremental.GetSize());
+  EXPECT_EQ(1, incremental.GetMatrix() == bordered);
+  EXPECT_NEAR(bordered.Determinant(), incremental.GetDeterminant(), 1e-12);
+  ExpectNear(bordered.InverseMatrix(), incremental.GetInverse(), 1e-12);
+
+  // the singularity test does not depend on the scale of the values
+  S21IncrementalInverse tiny(matrix * 1e-12);
+  row.Scale(1e-12);
+  col.Scale(1e-12);
+  tiny.AppendRowCol(row, col, 2e-12);
+  ExpectNear(bordered.InverseMatrix(), tiny.GetInverse() * 1e-12, 1e-9);
+  EXPECT_THROW(tiny.AppendRowCol(S21Vector(3), S21Vector(3), 0),
+               std::range_error);
+}
+
+TEST_F(S21MatrixTest, IncrementalInverseRefactorize) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = 1, matrix(1, 1) = 1;
+  S21IncrementalInverse incremental(matrix, 3);
+  EXPECT_EQ(3, incremental.GetRefactorPeriod());
+  S21Vector u(2);
+  S21Vector v(2);
+  u(0) = 1, v(1) = 0.1;
+  for (int i = 0; i < 10; i++) {
+    incremental.RankOneUpdate(u, v);
+  }
+  EXPECT_NEAR(1, incremental.GetDeterminant(), 1e-12);
+  EXPECT_NEAR(-1, incremental.GetInverse()(0, 1), 1e-12);
+}
+
+TEST_F(S21MatrixTest, IncrementalInverseException) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = 1, matrix(1, 1) = 1;
+  S21IncrementalInverse incremental(matrix);
+  S21Vector u(2);
+  S21Vector v(2);
+  u(0) = 1, v(0) = -1;
+  EXPECT_THROW(incremental.RankOneUpdate(u, v), std::range_error);
+  EXPECT_EQ(1, incremental.GetMatrix() == matrix);
+  EXPECT_DOUBLE_EQ(1, incremental.GetDeterminant());
+  EXPECT_THROW(incremental.RankOneUpdate(u, S21Vector(3)), std::range_error);
+  EXPECT_THROW(incremental.ReplaceRow(2, u), std::out_of_range);
+  EXPECT_THROW(S21IncrementalInverse wrong(S21Matrix(2, 2)), std::range_error);
+  EXPECT_THROW(S21IncrementalInverse wrong(*matrix_2x3), std::range_error);
+  EXPECT_THROW(S21IncrementalInverse wrong(matrix, 0), std::invalid_argument);
+}
+
+// CACHE
+
+TEST_F(S21MatrixTest, CacheHitsAndMisses) {
+  S21MatrixCache cache(8, 1);
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2, matrix(0, 1) = 5, matrix(0, 2) = 7;
+  matrix(1, 0) = 6, matrix(1, 1) = 3, matrix(1, 2) = 4;
+  matrix(2, 0) = 5, matrix(2, 1) = -2, matrix(2, 2) = -3;
+  EXPECT_DOUBLE_EQ(-1, cache.Determinant(matrix));
+  EXPECT_DOUBLE_EQ(-1, cache.Determinant(matrix));
+  S21Matrix inverse = cache.InverseMatrix(matrix);
+  S21Matrix cached_inverse = cache.InverseMatrix(S21Matrix(matrix));
+  EXPECT_EQ(1, inverse == matrix.InverseMatrix());
+  EXPECT_EQ(1, cached_inverse == inverse);
+  EXPECT_EQ(1, cache.CalcComplements(matrix) == matrix.CalcComplements());
+  S21MatrixCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(3u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(3, cache.GetSize());
+  cache.Clear();
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+TEST_F(S21MatrixTest, CacheContentChange) {
+  S21MatrixCache cache(8);
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = 3, matrix(1, 1) = 4;
+  EXPECT_DOUBLE_EQ(12, cache.Determinant(matrix));
+  matrix(1, 1) = 5;
+  EXPECT_DOUBLE_EQ(15, cache.Determinant(matrix));
+  EXPECT_NE(S21MatrixCache::Hash(matrix), S21MatrixCache::Hash(*matrix_1x1));
+  EXPECT_EQ(S21MatrixCache::Hash(*matrix_21x21),
+            S21MatrixCache::Hash(S21Matrix(*matrix_21x21)));
+  EXPECT_EQ(0u, cache.GetStats().hits);
+}
+
+TEST_F(S21MatrixTest, CacheEviction) {
+  S21MatrixCache cache(2, 1);
+  S21Matrix matrix(1, 1);
+  for (int i = 1; i <= 3; i++) {
+    matrix(0, 0) = i;
+    cache.Determinant(matrix);
+  }
+  matrix(0, 0) = 3;
+  cache.Determinant(matrix);
+  matrix(0, 0) = 1;
+  cache.Determinant(matrix);
+  S21MatrixCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(4u, stats.misses);
+  EXPECT_EQ(2u, stats.evictions);
+  EXPECT_EQ(2, cache.GetSize());
+}
+
+TEST_F(S21MatrixTest, CacheConcurrentAccess) {
+  S21MatrixCache cache(16, 4);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&cache] {
+      S21Matrix matrix(2, 2);
+      for (int i = 0; i < 200; i++) {
+        matrix(0, 0) = i % 10, matrix(1, 1) = 2;
+        EXPECT_DOUBLE_EQ(2 * (i % 10), cache.Determinant(matrix));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  S21MatrixCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(800u, stats.hits + stats.misses);
+  EXPECT_GE(stats.hits, 700u);
+}
+
+TEST_F(S21MatrixTest, CacheException) {
+  S21MatrixCache cache(4);
+  EXPECT_THROW(cache.Determinant(*matrix_2x3), std::range_error);
+  EXPECT_THROW(cache.InverseMatrix(S21Matrix(2, 2)), std::range_error);
+  EXPECT_EQ(0, cache.GetSize());
+  EXPECT_THROW(S21MatrixCache wrong(0), std::invalid_argument);
+}
+
+// MATRIX CHAIN
+
+TEST_F(S21MatrixTest, MatrixChainPlan) {
+  S21Matrix a(100, 2), b(2, 100), c(100, 3);
+  S21MatrixChain chain({a, b, c});
+  EXPECT_EQ("(A0 (A1 A2))", chain.GetPlan());
+  EXPECT_DOUBLE_EQ(2 * (2 * 100 * 3 + 100 * 2 * 3), chain.GetCost());
+  EXPECT_DOUBLE_EQ(2 * (100 * 2 * 100 + 100 * 100 * 3),
+                   chain.GetLeftToRightCost());
+  EXPECT_EQ("A0", S21MatrixChain({a}).GetPlan());
+}
+
+TEST_F(S21MatrixTest, MatrixChainMatchesOperator) {
+  S21Matrix a(7, 3), b(3, 11), c(11, 2), d(2, 9), e(9, 4);
+  for (S21Matrix* factor : {&a, &b, &c, &d, &e}) {
+    FillMatrixWithRandomDouble(*factor);
+  }
+  ExpectNear(a * b * c * d * e, MultiplyChain({a, b, c, d, e}), 1e-9);
+  ExpectNear(*matrix_12x21, MultiplyChain({*matrix_12x21}), 0);
+}
+
+TEST_F(S21MatrixTest, MatrixChainLarge) {
+  S21Matrix a(120, 80), b(80, 90), c(90, 60);
+  for (S21Matrix* factor : {&a, &b, &c}) {
+    FillMatrixWithRandomDouble(*factor);
+  }
+  ExpectNear(a * b * c, MultiplyChain({a, b, c}), 1e-6);
+}
+
+TEST_F(S21MatrixTest, MatrixChainException) {
+  EXPECT_THROW(MultiplyChain({}), std::invalid_argument);
+  EXPECT_THROW(MultiplyChain({*matrix_2x3, *matrix_2x3}), std::range_error);
+}
+
+// DISK MATRIX
+
+TEST_F(S21MatrixTest, DiskMatrixRoundTrip) {
+  std::string path = testing::TempDir() + "s21_disk_round_trip.bin";
+  {
+    S21DiskMatrix disk(path, *matrix_12x21);
+    disk(0, 0) = 322;
+    disk.Sync();
+  }
+  S21DiskMatrix read_only(path);
+  const S21DiskMatrix& disk = read_only;
+  EXPECT_EQ(12, disk.GetRows());
+  EXPECT_EQ(21, disk.GetCols());
+  EXPECT_FALSE(disk.IsWritable());
+  EXPECT_DOUBLE_EQ(322, disk(0, 0));
+  EXPECT_DOUBLE_EQ((*matrix_12x21)(11, 20), disk(11, 20));
+  EXPECT_THROW(read_only(0, 0) = 1, std::runtime_error);
+
+  S21DiskMatrix writable(path, S21DiskMatrix::Mode::kReadWrite);
+  writable.WriteBlock(1, 3, *matrix_2x3);
+  EXPECT_EQ(1, writable.ReadBlock(1, 3, 2, 3) == *matrix_2x3);
+  EXPECT_DOUBLE_EQ(-5.0, disk(2, 3));
+  EXPECT_THROW(writable.ReadBlock(11, 20, 2, 1), std::out_of_range);
+  std::remove(path.c_str());
+}
+
+TEST_F(S21MatrixTest, DiskMatrixMultiply) {
+  std::string a_path = testing::TempDir() + "s21_disk_a.bin";
+  std::string b_path = testing::TempDir() + "s21_disk_b.bin";
+  std::string c_path = testing::TempDir() + "s21_disk_c.bin";
+  S21Matrix a(50, 37), b(37, 45);
+  FillMatrixWithRandomDouble(a);
+  FillMatrixWithRandomDouble(b);
+  S21DiskMatrix disk_a(a_path, a);
+  S21DiskMatrix disk_b(b_path, b);
+
+  // 16 x 16 tiles leave partial tiles on every edge
+  std::size_t peak_memory = 6 * sizeof(double) * 16 * 16;
+  disk_a.Multiply(disk_b, c_path, peak_memory);
+  ExpectNear(a * b, S21DiskMatrix(c_path).ToMatrix(), 1e-9);
+  ExpectNear(a * b, disk_a.Multiply(disk_b, c_path).ToMatrix(), 1e-9);
+  EXPECT_THROW(disk_a.Multiply(disk_b, a_path), std::invalid_argument);
+  EXPECT_THROW(disk_a.Multiply(disk_b, b_path), std::invalid_argument);
+  EXPECT_EQ(1, disk_b.ToMatrix() == b);
+  for (const std::string& path : {a_path, b_path, c_path}) {
+    std::remove(path.c_str());
+  }
+}
+
+TEST_F(S21MatrixTest, DiskMatrixException) {
+  std::string path = testing::TempDir() + "s21_disk_invalid.bin";
+  EXPECT_THROW(S21DiskMatrix disk(path + ".missing"), std::system_error);
+  std::ofstream(path) << "not a matrix";
+  EXPECT_THROW(S21DiskMatrix disk(path), std::runtime_error);
+  EXPECT_THROW(S21DiskMatrix disk(path, 0, 3), std::invalid_argument);
+
+  S21DiskMatrix disk(path, *matrix_2x3);
+  EXPECT_THROW(disk.Multiply(disk, path + ".product"), std::range_error);
+  S21DiskMatrix square(path, *matrix_5x5);
+  EXPECT_THROW(square.Multiply(square, path + ".product", 0),
+               std::invalid_argument);
+  std::remove(path.c_str());
+}
+
+// SHARED MATRIX
+
+TEST_F(S21MatrixTest, SharedMatrixAttach) {
+  std::string name = "/s21_attach_" + std::to_string(getpid());
+  S21SharedMatrix publisher(name, *matrix_12x21);
+  S21SharedMatrix reader(name);
+  EXPECT_TRUE(publisher.IsPublisher());
+  EXPECT_FALSE(reader.IsPublisher());
+  EXPECT_EQ(12, reader.GetRows());
+  EXPECT_EQ(21, reader.GetCols());
+  EXPECT_EQ(1u, reader.GetGeneration());
+  EXPECT_EQ(1, reader.ToMatrix() == *matrix_12x21);
+  EXPECT_DOUBLE_EQ((*matrix_12x21)(3, 4), reader.Row(3)[4]);
+  EXPECT_EQ(12 * 21, reader.end() - reader.begin());
+
+  // the reader sees the update in place, without attaching again
+  S21Matrix updated = *matrix_12x21 * 2;
+  publisher.Update(updated);
+  EXPECT_EQ(2u, reader.GetGeneration());
+  EXPECT_DOUBLE_EQ(updated(11, 20), reader(11, 20));
+  EXPECT_THROW(reader.Update(updated), std::logic_error);
+  EXPECT_THROW(publisher.Update(*matrix_2x3), std::range_error);
+  EXPECT_THROW(reader(12, 0), std::out_of_range);
+}
+
+TEST_F(S21MatrixTest, SharedMatrixOtherProcess) {
+  std::string name = "/s21_process_" + std::to_string(getpid());
+  S21SharedMatrix publisher(name, *matrix_21x21);
+  pid_t child = fork();
+  ASSERT_NE(-1, child);
+  if (child == 0) {
+    // the child must not return into the test runner
+    try {
+      S21SharedMatrix reader(name);
+      _exit(reader.ToMatrix() == *matrix_21x21 ? 0 : 1);
+    } catch (...) {
+      _exit(2);
+    }
+  }
+
+  int status = 0;
+  waitpid(child, &status, 0);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+}
+
+TEST_F(S21MatrixTest, SharedMatrixException) {
+  std::string name = "/s21_invalid_" + std::to_string(getpid());
+  EXPECT_THROW(S21SharedMatrix matrix("no_slash", *matrix_2x3),
+               std::invalid_argument);
+  EXPECT_THROW(S21SharedMatrix matrix(name), std::system_error);
+  {
+    S21SharedMatrix publisher(name, *matrix_2x3);
+    EXPECT_THROW(S21SharedMatrix matrix(name, *matrix_2x3),
+                 std::system_error);
+  }
+  // the publisher removes the segment
+  EXPECT_FALSE(S21SharedMatrix::Unlink(name));
+}
+
+// EIGEN
+
+TEST_F(S21MatrixTest, DominantEigen) {
+  // reflecting diag(10, 5, 2, 1) keeps the eigenvalues
+  S21Matrix diagonal(4, 4), reflection(4, 4);
+  double values[] = {10, 5, 2, 1};
+  for (int i = 0; i < 4; i++) {
+    diagonal(i, i) = values[i];
+    for (int j = 0; j < 4; j++) {
+      reflection(i, j) = (i == j) - 0.5;
+    }
+  }
+  S21Matrix matrix = reflection * diagonal * reflection;
+
+  std::vector<S21EigenPair> pairs = DominantEigen(matrix, 2);
+  ASSERT_EQ(2u, pairs.size());
+  for (int i = 0; i < 2; i++) {
+    EXPECT_NEAR(values[i], pairs[i].value, 1e-8);
+    S21Vector residual = matrix * pairs[i].vector;
+    residual.Axpy(-pairs[i].value, pairs[i].vector);
+    EXPECT_NEAR(0, residual.Norm(), 1e-8);
+    EXPECT_NEAR(1, pairs[i].vector.Norm(), 1e-12);
+  }
+
+  S21Matrix negative(3, 3);
+  negative(0, 0) = 1;
+  negative(1, 1) = -7;
+  negative(2, 2) = 3;
+  EXPECT_NEAR(-7, DominantEigen(negative)[0].value, 1e-8);
+}
+
+TEST_F(S21MatrixTest, LanczosEigen) {
+  // the second difference matrix has the eigenvalues 2 - 2cos(k pi / (n + 1))
+  int size = 100;
+  S21Matrix laplacian(size, size);
+  for (int i = 0; i < size; i++) {
+    laplacian(i, i) = 2;
+    if (i > 0) {
+      laplacian(i, i - 1) = laplacian(i - 1, i) = -1;
+    }
+  }
+
+  std::vector<S21EigenPair> pairs = LanczosEigen(laplacian, 3);
+  ASSERT_EQ(3u, pairs.size());
+  for (int k = 0; k < 3; k++) {
+    double expected = 2 - 2 * std::cos((size - k) * M_PI / (size + 1));
+    EXPECT_NEAR(expected, pairs[k].value, 1e-8);
+    S21Vector residual = laplacian * pairs[k].vector;
+    residual.Axpy(-pairs[k].value, pairs[k].vector);
+    EXPECT_NEAR(0, residual.Norm(), 1e-6);
+  }
+}
+
+TEST_F(S21MatrixTest, EigenCallbackOperator) {
+  // the matrix is never formed
+  int size = 300;
+  S21LinearOperator laplacian = [size](const S21Vector& x, S21Vector& y) {
+    for (int i = 0; i < size; i++) {
+      y(i) = 2 * x(i) - (i > 0 ? x(i - 1) : 0) - (i + 1 < size ? x(i + 1) : 0);
+    }
+  };
+  std::vector<S21EigenPair> pairs = LanczosEigen(laplacian, size, 2);
+  EXPECT_NEAR(2 - 2 * std::cos(size * M_PI / (size + 1)), pairs[0].value,
+              1e-8);
+  EXPECT_GT(pairs[0].value, pairs[1].value);
+
+  S21LinearOperator scaled = [](const S21Vector& x, S21Vector& y) {
+    for (int i = 0; i < 3; i++) {
+      y(i) = (i + 1) * x(i);
+    }
+  };
+  EXPECT_NEAR(3, DominantEigen(scaled, 3)[0].value, 1e-8);
+}
+
+TEST_F(S21MatrixTest, EigenException) {
+  EXPECT_THROW(DominantEigen(*matrix_2x3), std::range_error);
+  EXPECT_THROW(LanczosEigen(*matrix_21x21 * 2 + matrix_21x21->Transpose(), 1),
+               std::range_error);
+  S21Matrix symmetric = *matrix_21x21 + matrix_21x21->Transpose();
+  EXPECT_THROW(LanczosEigen(symmetric, 22), std::invalid_argument);
+  EXPECT_THROW(DominantEigen(symmetric, 0), std::invalid_argument);
+}
+
+// ASYNC
+
+TEST_F(S21MatrixTest, AsyncMul) {
+  async::Future<S21Matrix> product = async::Mul(*matrix_12x21, *matrix_21x21);
+  S21Matrix reference_matrix = (*matrix_12x21) * (*matrix_21x21);
+  EXPECT_EQ(1, product.Get() == reference_matrix);
+}
+
+TEST_F(S21MatrixTest, AsyncChain) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2, matrix(0, 1) = 5, matrix(0, 2) = 7;
+  matrix(1, 0) = 6, matrix(1, 1) = 3, matrix(1, 2) = 4;
+  matrix(2, 0) = 5, matrix(2, 1) = -2, matrix(2, 2) = -3;
+  async::Future<S21Matrix> source(matrix);
+  async::Future<S21Matrix> inverse = async::Inverse(source);
+  async::Future<double> det = async::Determinant(source);
+  async::Future<S21Matrix> identity = async::Mul(source, inverse);
+  async::Future<double> trace = identity.Then([](const S21Matrix& m) {
+    return m(0, 0) + m(1, 1) + m(2, 2);
+  });
+  EXPECT_DOUBLE_EQ(-1, det.Get());
+  EXPECT_NEAR(3, trace.Get(), 1e-9);
+  EXPECT_NEAR(-38, inverse.Get()(1, 0), 1e-9);
+}
+
+TEST_F(S21MatrixTest, AsyncIndependentOperations) {
+  async::Future<S21Matrix> source(*matrix_21x21);
+  std::vector<async::Future<S21Matrix>> results;
+  for (int i = 0; i < 8; i++) {
+    results.push_back(async::Mul(source, i));
+  }
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(1, results[i].Get() == (*matrix_21x21) * i);
+  }
+}
+
+TEST_F(S21MatrixTest, AsyncException) {
+  async::Future<S21Matrix> product = async::Mul(*matrix_1x1, *matrix_2x3);
+  async::Future<S21Matrix> transposed = async::Transpose(product);
+  EXPECT_THROW(product.Get(), std::range_error);
+  EXPECT_THROW(transposed.Get(), std::range_error);
+}
+
+// TRACE
+
+TEST_F(S21MatrixTest, TraceRecordsOutermostCalls) {
+  std::string path = testing::TempDir() + "s21_trace.s21trace";
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2, matrix(0, 1) = 5, matrix(0, 2) = 7;
+  matrix(1, 0) = 6, matrix(1, 1) = 3, matrix(1, 2) = 4;
+  matrix(2, 0) = 5, matrix(2, 1) = -2, matrix(2, 2) = -3;
+  EXPECT_FALSE(S21TraceRecorder::IsRecording());
+  S21TraceRecorder::Start(path);
+  EXPECT_TRUE(S21TraceRecorder::IsRecording());
+  S21Matrix product = (*matrix_12x21) * (*matrix_21x21);
+  // Determinant, CalcComplements, Transpose and Solve run inside
+  S21Matrix inverse = matrix.InverseMatrix();
+  S21Matrix power = matrix.Pow(-2);
+  EXPECT_THROW(matrix_1x1->MulMatrix(*matrix_2x3), std::range_error);
+  S21TraceRecorder::Stop();
+  EXPECT_FALSE(S21TraceRecorder::IsRecording());
+  matrix.Transpose();
+
+  std::vector<S21TraceRecord> records = S21TraceRecorder::Read(path);
+  ASSERT_EQ(4u, records.size());
+  EXPECT_EQ(S21TraceOp::kMulMatrix, records[0].op);
+  EXPECT_EQ(12, records[0].rows);
+  EXPECT_EQ(21, records[0].cols);
+  EXPECT_EQ(21, records[0].other_rows);
+  EXPECT_EQ(21, records[0].other_cols);
+  EXPECT_EQ(S21TraceOp::kInverseMatrix, records[1].op);
+  EXPECT_EQ(0, records[1].other_rows);
+  EXPECT_EQ(S21TraceOp::kPow, records[2].op);
+  EXPECT_EQ(-2, records[2].argument);
+  EXPECT_EQ(S21TraceOp::kMulMatrix, records[3].op);
+  EXPECT_EQ(2, records[3].other_rows);
+  for (std::size_t i = 1; i < records.size(); i++) {
+    EXPECT_GE(records[i].start_ns,
+              records[i - 1].start_ns + records[i - 1].duration_ns);
+  }
+  std::remove(path.c_str());
+}
+
+TEST_F(S21MatrixTest, TraceRecordsReductionsFactoriesAndUpdates) {
+  std::string path = testing::TempDir() + "s21_trace_more.s21trace";
+  S21Matrix symmetric = *matrix_21x21 + matrix_21x21->Transpose();
+  S21Matrix diagonal = S21Matrix::Identity(4) * 2;
+  S21IncrementalInverse incremental(diagonal);
+  S21Vector values(4);
+  values(0) = 3;
+  S21TraceRecorder::Start(path);
+  // MaxAbs runs inside when the squares leave the range of double
+  S21Matrix::Filled(2, 3, 1e200).NormFrobenius();
+  matrix_12x21->ColSums();
+  LanczosEigen(symmetric, 2);
+  incremental.ReplaceRow(0, values);
+  S21TraceRecorder::Stop();
+
+  std::vector<S21TraceRecord> records = S21TraceRecorder::Read(path);
+  ASSERT_EQ(5u, records.size());
+  EXPECT_EQ(S21TraceOp::kFilled, records[0].op);
+  EXPECT_EQ(S21TraceOp::kNormFrobenius, records[1].op);
+  EXPECT_EQ(3, records[1].cols);
+  EXPECT_EQ(S21TraceOp::kColSums, records[2].op);
+  EXPECT_EQ(S21TraceOp::kLanczosEigen, records[3].op);
+  EXPECT_EQ(21, records[3].rows);
+  EXPECT_EQ(2, records[3].argument);
+  EXPECT_EQ(S21TraceOp::kReplaceRow, records[4].op);
+  EXPECT_EQ(4, records[4].rows);
+  EXPECT_STREQ("AppendRowCol",
+               S21TraceRecorder::OpName(S21TraceOp::kAppendRowCol));
+  std::remove(path.c_str());
+}
+
+TEST_F(S21MatrixTest, TraceErrors) {
+  std::string path = testing::TempDir() + "s21_trace_errors.s21trace";
+  S21TraceRecorder::Start(path);
+  EXPECT_THROW(S21TraceRecorder::Start(path), std::logic_error);
+  S21TraceRecorder::Stop();
+  S21TraceRecorder::Stop();
+  EXPECT_TRUE(S21TraceRecorder::Read(path).empty());
+  EXPECT_STREQ("InverseMatrix",
+               S21TraceRecorder::OpName(S21TraceOp::kInverseMatrix));
+
+  std::ofstream(path) << "not a trace of matrix calls";
+  EXPECT_THROW(S21TraceRecorder::Read(path), std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(S21TraceRecorder::Read(path), std::system_error);
+  EXPECT_THROW(S21TraceRecorder::Start(testing::TempDir() + "no/such/dir"),
+               std::system_error);
+}
+
 // UNIT TEST END
 
 }  // namespace s_21
@@ -0,0 +1,303 @@
+//  created by sheritsh // Oleg Polovinko ※ School 21, Kzn
+
+// Replays a trace of S21TraceRecorder on random matrices of the recorded
+// shapes and reports the latency percentiles per operation, over all calls
+// and of the whole trace per pass next to the recorded ones.
+//
+//   make replay TRACE=service.s21trace [REPEAT=3]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../s21_eigen.h"
+#include "../s21_incremental_inverse.h"
+#include "../s21_matrix_oop.h"
+#include "../s21_trace.h"
+#include "../s21_vector.h"
+
+namespace {
+using s_21::S21IncrementalInverse;
+using s_21::S21Matrix;
+using s_21::S21TraceOp;
+using s_21::S21TraceRecord;
+using s_21::S21TraceRecorder;
+using s_21::S21Vector;
+using Clock = std::chrono::steady_clock;
+
+struct Latencies {
+  std::vector<std::uint64_t> recorded, replayed;
+  int failed = 0;
+};
+
+// Operands are generated once per shape. Square ones get a dominant diagonal
+// so that Solve, InverseMatrix and negative powers never meet a singular one.
+class Operands {
+ public:
+  const S21Matrix& Get(int rows, int cols) {
+    auto found = matrices_.find({rows, cols});
+    if (found == matrices_.end()) {
+      S21Matrix matrix = S21Matrix::Random(
+          rows, cols, S21Matrix::Distribution::Uniform(-1, 1),
+          static_cast<std::uint64_t>(rows) << 32 | cols);
+      if (rows == cols) {
+        for (int i = 0; i < rows; i++) {
+          matrix(i, i) += rows;
+        }
+      }
+      found = matrices_.emplace(std::make_pair(rows, cols), matrix).first;
+    }
+
+    return found->second;
+  }
+
+ private:
+  std::map<std::pair<int, int>, S21Matrix> matrices_;
+};
+
+// The spectrum of a recorded eigensolver call is not known. The replayed
+// matrices are dense and symmetric with the largest eigenvalues near 1, 1/2,
+// 1/4 and so on, so that the power iteration converges in a few dozen steps.
+S21Matrix Symmetric(const S21Matrix& matrix) {
+  int size = matrix.GetRows();
+  S21Matrix symmetric = (matrix + matrix.Transpose()) * (1e-3 / size);
+  for (int i = 0; i < size; i++) {
+    symmetric(i, i) = std::ldexp(1, std::max(i + 1 - size, -1000));
+  }
+
+  return symmetric;
+}
+
+// keeps the results alive so that no call is optimized away
+volatile double sink = 0;
+
+template <typename Call>
+std::uint64_t Time(Call call) {
+  Clock::time_point start = Clock::now();
+  call();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                              start)
+      .count();
+}
+
+std::uint64_t Replay(const S21TraceRecord& record, Operands& operands) {
+  const S21Matrix& other =
+      record.other_rows ? operands.Get(record.other_rows, record.other_cols)
+                        : operands.Get(record.rows, record.cols);
+  // the mutating calls get a private copy, its deep copy is not timed
+  S21Matrix matrix(operands.Get(record.rows, record.cols));
+  matrix.Detach();
+  switch (record.op) {
+    case S21TraceOp::kSumMatrix:
+      return Time([&] { matrix.SumMatrix(other); });
+    case S21TraceOp::kSubMatrix:
+      return Time([&] { matrix.SubMatrix(other); });
+    case S21TraceOp::kMulNumber:
+      return Time([&] { matrix.MulNumber(1.5); });
+    case S21TraceOp::kMulMatrix:
+      return Time([&] { matrix.MulMatrix(other); });
+    case S21TraceOp::kTranspose:
+      return Time([&] { sink = matrix.Transpose()(0, 0); });
+    case S21TraceOp::kCalcComplements:
+      return Time([&] { sink = matrix.CalcComplements()(0, 0); });
+    case S21TraceOp::kDeterminant:
+      return Time([&] { sink = matrix.Determinant(); });
+    case S21TraceOp::kInverseMatrix:
+      return Time([&] { sink = matrix.InverseMatrix()(0, 0); });
+    case S21TraceOp::kSolve:
+      return Time([&] { sink = matrix.Solve(other)(0, 0); });
+    case S21TraceOp::kPow:
+      return Time([&] { sink = matrix.Pow(record.argument)(0, 0); });
+    case S21TraceOp::kExp:
+      return Time([&] { sink = matrix.Exp()(0, 0); });
+    case S21TraceOp::kGemv: {
+      S21Vector x(record.cols), y(record.rows);
+      return Time([&] { matrix.Gemv(1, x, 0, y); });
+    }
+    case S21TraceOp::kGevm: {
+      S21Vector x(record.rows), y(record.cols);
+      return Time([&] { matrix.Gevm(1, x, 0, y); });
+    }
+    case S21TraceOp::kSum:
+      return Time([&] { sink = matrix.Sum(); });
+    case S21TraceOp::kTrace:
+      return Time([&] { sink = matrix.Trace(); });
+    case S21TraceOp::kNormFrobenius:
+      return Time([&] { sink = matrix.NormFrobenius(); });
+    case S21TraceOp::kNorm1:
+      return Time([&] { sink = matrix.Norm1(); });
+    case S21TraceOp::kNormInf:
+      return Time([&] { sink = matrix.NormInf(); });
+    case S21TraceOp::kMaxAbs:
+      return Time([&] { sink = matrix.MaxAbs(); });
+    case S21TraceOp::kRowSums:
+      return Time([&] { sink = matrix.RowSums()(0); });
+    case S21TraceOp::kColSums:
+      return Time([&] { sink = matrix.ColSums()(0); });
+    case S21TraceOp::kIdentity:
+      return Time([&] { sink = S21Matrix::Identity(record.rows)(0, 0); });
+    case S21TraceOp::kFilled:
+      return Time([&] {
+        sink = S21Matrix::Filled(record.rows, record.cols, 1.5)(0, 0);
+      });
+    case S21TraceOp::kRandom:
+      return Time([&] {
+        sink = S21Matrix::Random(record.rows, record.cols,
+                                 S21Matrix::Distribution::Normal(0, 1),
+                                 21)(0, 0);
+      });
+    case S21TraceOp::kFromBuffer: {
+      std::vector<double> buffer(
+          static_cast<std::size_t>(record.rows) * record.argument, 1.5);
+      return Time([&] {
+        sink = S21Matrix::FromBuffer(buffer.data(), record.rows, record.cols,
+                                     record.argument)(0, 0);
+      });
+    }
+    case S21TraceOp::kDominantEigen: {
+      S21Matrix symmetric = Symmetric(matrix);
+      return Time([&] {
+        sink = s_21::DominantEigen(symmetric, record.argument)[0].value;
+      });
+    }
+    case S21TraceOp::kLanczosEigen: {
+      S21Matrix symmetric = Symmetric(matrix);
+      return Time([&] {
+        sink = s_21::LanczosEigen(symmetric, record.argument)[0].value;
+      });
+    }
+    case S21TraceOp::kRankOneUpdate:
+    case S21TraceOp::kReplaceRow:
+    case S21TraceOp::kReplaceCol:
+    case S21TraceOp::kAppendRowCol: {
+      // the decomposition of the operand is not part of the update
+      S21IncrementalInverse incremental(matrix);
+      S21Vector u(record.rows), v(record.rows), row(record.rows),
+          col(record.rows);
+      u(0) = 1, v(record.rows - 1) = 0.5;
+      // the first row and col with a larger diagonal value
+      for (int i = 0; i < record.rows; i++) {
+        row(i) = matrix(0, i) + (i == 0);
+        col(i) = matrix(i, 0) + (i == 0);
+      }
+      if (record.op == S21TraceOp::kRankOneUpdate) {
+        return Time([&] { incremental.RankOneUpdate(u, v); });
+      } else if (record.op == S21TraceOp::kReplaceRow) {
+        return Time([&] { incremental.ReplaceRow(0, row); });
+      } else if (record.op == S21TraceOp::kReplaceCol) {
+        return Time([&] { incremental.ReplaceCol(0, col); });
+      }
+      return Time([&] { incremental.AppendRowCol(v, v, record.rows + 1); });
+    }
+    default:
+      return 0;
+  }
+}
+
+// nearest rank, the values are sorted
+double Percentile(const std::vector<std::uint64_t>& values, int percent) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::size_t rank = (values.size() * percent + 99) / 100;
+
+  return values[std::max<std::size_t>(rank, 1) - 1] / 1e3;
+}
+
+void PrintRow(const char* name, Latencies& latencies) {
+  std::sort(latencies.recorded.begin(), latencies.recorded.end());
+  std::sort(latencies.replayed.begin(), latencies.replayed.end());
+  std::printf("%-16s %8zu %6d %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+              name, latencies.replayed.size(), latencies.failed,
+              Percentile(latencies.recorded, 50),
+              Percentile(latencies.recorded, 99),
+              Percentile(latencies.replayed, 50),
+              Percentile(latencies.replayed, 90),
+              Percentile(latencies.replayed, 99),
+              Percentile(latencies.replayed, 100));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    std::fprintf(stderr, "usage: %s TRACE [REPEAT]\n", argv[0]);
+    return 2;
+  }
+  int repeat = argc == 3 ? std::atoi(argv[2]) : 1;
+  if (repeat < 1) {
+    std::fprintf(stderr, "REPEAT must be a positive number\n");
+    return 2;
+  }
+
+  std::vector<S21TraceRecord> records;
+  try {
+    records = S21TraceRecorder::Read(argv[1]);
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+  if (records.empty()) {
+    std::fprintf(stderr, "%s: the trace is empty\n", argv[1]);
+    return 1;
+  }
+
+  Operands operands;
+  std::vector<Latencies> per_op(static_cast<int>(S21TraceOp::kCount));
+  // one sample per pass: the time spent in all calls of the trace
+  Latencies all, trace;
+  std::uint64_t recorded_busy = 0, recorded_span = 0;
+  Clock::time_point start = Clock::now();
+  for (int pass = 0; pass < repeat; pass++) {
+    std::uint64_t replayed_busy = 0;
+    for (const S21TraceRecord& record : records) {
+      Latencies& latencies = per_op[static_cast<int>(record.op)];
+      std::uint64_t duration = 0;
+      try {
+        duration = Replay(record, operands);
+      } catch (const std::exception&) {
+        // the recorded call failed in the same way, e.g. wrong dimensions
+        latencies.failed++;
+        all.failed++;
+        continue;
+      }
+      latencies.recorded.push_back(record.duration_ns);
+      latencies.replayed.push_back(duration);
+      all.recorded.push_back(record.duration_ns);
+      all.replayed.push_back(duration);
+      if (pass == 0) {
+        recorded_busy += record.duration_ns;
+        recorded_span = std::max(recorded_span,
+                                 record.start_ns + record.duration_ns);
+      }
+      replayed_busy += duration;
+    }
+    trace.recorded.push_back(recorded_busy);
+    trace.replayed.push_back(replayed_busy);
+  }
+  double wall = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::printf("%zu calls x %d passes from %s, latencies in us\n\n",
+              records.size(), repeat, argv[1]);
+  std::printf("%-16s %8s %6s %10s %10s %10s %10s %10s %10s\n", "operation",
+              "calls", "failed", "rec p50", "rec p99", "p50", "p90", "p99",
+              "max");
+  for (int op = 0; op < static_cast<int>(S21TraceOp::kCount); op++) {
+    if (!per_op[op].replayed.empty() || per_op[op].failed) {
+      PrintRow(S21TraceRecorder::OpName(static_cast<S21TraceOp>(op)),
+               per_op[op]);
+    }
+  }
+  PrintRow("all", all);
+  PrintRow("whole trace", trace);
+
+  std::printf("\nrecorded calls spread over %.3f ms, replayed in %.3f s\n",
+              recorded_span / 1e6, wall);
+
+  return 0;
+}